@@ -4,236 +4,1461 @@
  * @brief Définition des méthodes de la classe Ancetre
 **/
 #include "ancetres.hpp" // pour le type Ancetres
-#include <fstream> // pour le type std::ifstream
-#include <sstream> // pour le type std::stringstream
+#include "projection.hpp" // pour le type Projection
+#include "tamponsortie.hpp" // pour le type TamponSortie
+#include <cstring> // pour std::memchr, std::memcpy, std::memcmp et std::strlen
+#include <fstream> // pour le type std::ofstream
+#include <algorithm> // pour std::min et std::max
+#include <thread> // pour le type std::thread
+#include <exception> // pour le type std::exception_ptr
+#include <stdexcept> // pour les types std::out_of_range et std::length_error
+#include <unordered_map> // pour le type std::unordered_map
 #include <cassert> // pour les assertions
+#include <atomic> // pour le type std::atomic
+#include <utility> // pour std::move
+
+const std::size_t Ancetres::NOM_MAX;
 
 //--------------------------------------------------------------------
 Ancetres::Ancetres()
-: noeuds(0) // vecteur vide
+: generationsAJour(false),
+  generationsCycle(false)
 {}
 
 //--------------------------------------------------------------------
-Ancetres::Ancetres(std::string fic)
-: noeuds(0) // vecteur vide
+// dernier numéro d'espace attribué, partagé par toutes les forêts
+static std::atomic<std::uint64_t> dernierEspace(0);
+
+Ancetres::Espace::Espace() : numero(++dernierEspace) {}
+
+Ancetres::Espace::Espace(const Espace &) : numero(++dernierEspace) {}
+
+Ancetres::Espace & Ancetres::Espace::operator=(const Espace &)
+{
+    numero = ++dernierEspace;
+    return *this;
+}
+
+//--------------------------------------------------------------------
+std::uint64_t Ancetres::espace() const
+{
+    return numeroEspace.numero;
+}
+
+//--------------------------------------------------------------------
+void Ancetres::figer() const
 {
-    // ouverture du fichier ...
-    std::ifstream f(fic);
-    // ... supposé fonctionner
-    assert(f.is_open());
+    calculerGenerations();
+}
+
+//--------------------------------------------------------------------
+bool Ancetres::renumeroter()
+{
+    // ordre topologique des enfants vers les parents (Kahn, file FIFO) : un nœud entre dans l'ordre
+    // quand son dernier enfant y est rangé, et le père et la mère libérés par un même enfant se suivent
+    std::size_t n = noeuds.size();
+    std::vector<std::uint32_t> restants(nbEnfants.begin(), nbEnfants.end()); // enfants de chaque nœud pas encore rangés
+    std::vector<PersonId> ordre;
+    ordre.reserve(n);
+    for (PersonId id = 0; id < n; ++id)
+    	if (nbEnfants[id] == 0)
+    		ordre.push_back(id);
+    for (std::size_t i = 0; i < ordre.size(); ++i) {
+    	const Noeud & nd = noeuds[ordre[i]];
+    	if (nd.pere != -1 && --restants[nd.pere] == 0)
+    		ordre.push_back((PersonId)nd.pere);
+    	if (nd.mere != -1 && nd.mere != nd.pere && --restants[nd.mere] == 0)
+    		ordre.push_back((PersonId)nd.mere);
+    }
+    // un nœud resté à l'écart a un enfant jamais rangé : il est sur un cycle ou au-dessus d'un cycle
+    bool sansCycle = ordre.size() == n;
+    if (!sansCycle)
+    	for (PersonId id = 0; id < n; ++id)
+    		if (restants[id] != 0)
+    			ordre.push_back(id);
+
+    // nouveau numéro de chaque nœud, puis réécriture des nœuds, des liens et de la table des individus
+    std::vector<PersonId> vers(n);
+    for (PersonId i = 0; i < n; ++i)
+    	vers[ordre[i]] = i;
+    Segments<Noeud> ranges;
+    Segments<PersonId> rangsOrigine;
+    ranges.reserve(n);
+    rangsOrigine.reserve(n);
+    for (PersonId i = 0; i < n; ++i) {
+    	Noeud nd = noeuds[ordre[i]];
+    	if (nd.pere != -1)
+    		nd.pere = (int)vers[nd.pere];
+    	if (nd.mere != -1)
+    		nd.mere = (int)vers[nd.mere];
+    	ranges.push_back(nd);
+    	rangsOrigine.push_back(origine.empty() ? ordre[i] : origine[ordre[i]]);
+    }
+    noeuds = std::move(ranges);
+    origine = std::move(rangsOrigine);
+    idsOrigine.resize(n);
+    for (PersonId i = 0; i < n; ++i)
+    	idsOrigine[origine[i]] = i;
+    indTOnd.renumeroter(vers.data()); // le hachage ne dépend que du nom et de la clé : les cases restent en place
+
+    numeroEspace = Espace(); // les anciens identifiants ne désignent plus les mêmes individus
+    recompterEnfants();
+    generationsAJour = false;
+    return sansCycle;
+}
 
-    // tampon de lecture
-    std::string ligne;
+//--------------------------------------------------------------------
+PersonId Ancetres::numeroOrigine(PersonId id) const
+{
+    return origine.empty() ? id : origine[id];
+}
 
-    // première partie du fichier : créer les individus
-    std::getline(f,ligne);
-    while ( f.good()  and  ( ligne.at(0) == 'f'  or  ligne.at(0) == 'm' ) )
+//--------------------------------------------------------------------
+PersonId Ancetres::identifiantOrigine(PersonId rang) const
+{
+    return idsOrigine.empty() ? rang : idsOrigine[rang];
+}
+
+//--------------------------------------------------------------------
+// Outils de découpage d'un tampon en mémoire, sans recopie
+
+// saute les blancs d'une ligne (espaces, tabulations, retours chariot)
+static const char * sauterBlancs(const char * p, const char * fin)
+{
+    while (p < fin and (*p == ' ' or *p == '\t' or *p == '\r'))
+        ++p;
+    return p;
+}
+
+// donne la fin du mot commençant en p
+static const char * finMot(const char * p, const char * fin)
+{
+    while (p < fin and *p != ' ' and *p != '\t' and *p != '\r' and *p != '\n')
+        ++p;
+    return p;
+}
+
+// donne le début de la ligne suivant celle contenant p
+static const char * ligneSuivante(const char * p, const char * fin)
+{
+    const char * nl = static_cast<const char *>(std::memchr(p, '\n', (std::size_t)(fin-p)));
+    return nl == nullptr ? fin : nl+1;
+}
+
+// lit un entier positif et avance p après ses chiffres
+static unsigned int lireEntier(const char * & p, const char * fin)
+{
+    p = sauterBlancs(p,fin);
+    unsigned int n = 0;
+    while (p < fin and *p >= '0' and *p <= '9')
+        n = n*10 + (unsigned int)(*p++ - '0');
+    return n;
+}
+
+// découpe [deb,fin) en au plus k morceaux de lignes entières, bornes comprises
+static std::vector<const char *> decouper(const char * deb, const char * fin, unsigned int k)
+{
+    std::vector<const char *> bornes(1,deb);
+    std::size_t pas = (std::size_t)(fin-deb)/k;
+    for (unsigned int i = 1; i < k; ++i)
     {
-        std::stringstream ss(ligne);
-        Individu ind;
-        ss >> ind.sexe >> ind.nom >> ind.date; // déchiffrage des données
-        this->ajouter(ind); // ajout au moyen de la méthode éponyme
-        std::getline(f,ligne); // prochaine ligne
+        const char * b = deb + pas*i;
+        if (b <= bornes.back())
+            continue;
+        b = ligneSuivante(b-1,fin); // on recule d'un octet pour ne pas sauter une ligne qui commence en b
+        if (b > bornes.back() and b < fin)
+            bornes.push_back(b);
     }
+    bornes.push_back(fin);
+    return bornes;
+}
+
+// en deçà, un seul fil déchiffre le fichier : lancer des fils coûterait plus que le déchiffrage
+static const std::size_t TAILLE_MORCEAU_MIN = 1 << 20;
 
-    // deuxième partie : lier les individus
-    while ( f.good() )
+// applique f à chaque morceau de 0 à nbMorceaux-1, le premier dans le fil appelant et les autres chacun dans son fil ;
+// une exception levée par un morceau est relancée une fois tous les fils terminés
+template<class Tache>
+static void pourChaqueMorceau(std::size_t nbMorceaux, Tache f)
+{
+    std::vector<std::exception_ptr> erreurs(nbMorceaux);
+    auto protegee = [&f,&erreurs](std::size_t k) {
+        try {
+            f(k);
+        } catch (...) {
+            erreurs[k] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> taches;
+    for (std::size_t k = 1; k < nbMorceaux; ++k)
+        taches.emplace_back(protegee, k);
+    protegee(0);
+    for (std::thread & t : taches)
+        t.join();
+    for (std::exception_ptr & e : erreurs)
+        if (e)
+            std::rethrow_exception(e);
+}
+
+//--------------------------------------------------------------------
+Ancetres::Ancetres(std::string fic, unsigned int nbTaches)
+: Ancetres() // forêt vide
+{
+    // projection du fichier ...
+    Projection proj(fic);
+    // ... supposée fonctionner
+    assert(proj.ouverte());
+    const char * deb = proj.donnees(), * fin = deb + proj.taille();
+
+    // repérage de la frontière entre les deux parties
+    const char * milieu = deb;
+    while (milieu < fin and (*milieu == 'f' or *milieu == 'm'))
+        milieu = ligneSuivante(milieu,fin);
+
+    if (nbTaches == 0)
+        nbTaches = std::max(1u, std::thread::hardware_concurrency());
+
+    // première partie du fichier : chaque morceau est lu dans son propre tampon ...
+    std::vector<const char *> bornes = decouper(deb, milieu,
+        (unsigned int)std::min<std::size_t>(nbTaches, 1 + (std::size_t)(milieu-deb)/TAILLE_MORCEAU_MIN));
+    std::size_t nbMorceaux = bornes.size()-1;
+    std::vector<std::vector<Noeud>> nds(nbMorceaux);
+    std::vector<std::vector<std::string>> nomsLus(nbMorceaux);
+    pourChaqueMorceau(nbMorceaux, [&](std::size_t k) { lireIndividus(bornes[k], bornes[k+1], nds[k], nomsLus[k]); });
+
+    // ... puis les morceaux sont fusionnés dans l'ordre du fichier, ce qui conserve la numérotation
+    std::size_t n = 0;
+    for (const std::vector<Noeud> & morceau : nds)
+        n += morceau.size();
+    noeuds.reserve(n);
+    indTOnd.reserver(n);
+    for (std::size_t k = 0; k < nbMorceaux; ++k)
     {
-        std::stringstream ss(ligne);
-        int i, p, m; // numéros de l'individu, son père, sa mère
-        ss >> i >> p >> m; // déchiffrage des liens
-        Individu ind, per, mer; // individus correspondants
-        ind = noeuds.at(i-1).ind;
-        // enregistrement du père si connu
-        if ( p != 0 )
+        std::vector<std::uint32_t> global(nomsLus[k].size());
+        for (std::size_t j = 0; j < global.size(); ++j)
+            global[j] = interner(nomsLus[k][j].data(),nomsLus[k][j].size());
+        for (Noeud & nd : nds[k])
         {
-            per = noeuds.at(p-1).ind;
-            this->setPere(ind,per);
+            nd.nom = global[nd.nom];
+            noeuds.push_back(nd);
+            indexer((PersonId)noeuds.size()-1);
         }
-        // enregistrement de la mère si connue
-        if ( m != 0 )
+        std::vector<Noeud>().swap(nds[k]); // libération au fur et à mesure
+    }
+
+    // deuxième partie : lier les individus, par indice ; chaque nœud n'est écrit que par un seul morceau
+    bornes = decouper(milieu, fin,
+        (unsigned int)std::min<std::size_t>(nbTaches, 1 + (std::size_t)(fin-milieu)/TAILLE_MORCEAU_MIN));
+    nbMorceaux = bornes.size()-1;
+    std::vector<std::vector<Lien>> liens(nbMorceaux);
+    if (nbMorceaux == 1) {
+        lireLiens(bornes[0], bornes[1], noeuds.size(), liens[0]);
+        for (const Lien & l : liens[0]) { // dans l'ordre du fichier : la dernière ligne d'un individu l'emporte
+            noeuds[l.id].pere = l.pere;
+            noeuds[l.id].mere = l.mere;
+        }
+    } else {
+        // un individu peut avoir des lignes dans plusieurs morceaux : seul le dernier de ces morceaux pose ses liens,
+        // dans son ordre à lui, de sorte que la dernière ligne du fichier l'emporte comme en lecture séquentielle
+        std::vector<std::atomic<std::uint32_t>> dernier(noeuds.size());
+        for (std::atomic<std::uint32_t> & d : dernier)
+            d.store(0, std::memory_order_relaxed);
+        pourChaqueMorceau(nbMorceaux, [&](std::size_t k) {
+            lireLiens(bornes[k], bornes[k+1], noeuds.size(), liens[k]);
+            for (const Lien & l : liens[k]) {
+                std::uint32_t d = dernier[l.id].load(std::memory_order_relaxed);
+                while (d < k and !dernier[l.id].compare_exchange_weak(d, (std::uint32_t)k, std::memory_order_relaxed))
+                    ;
+            }
+        });
+        // les fils ont été rejoints : les morceaux gagnants sont connus de tous
+        pourChaqueMorceau(nbMorceaux, [&](std::size_t k) {
+            for (const Lien & l : liens[k])
+                if (dernier[l.id].load(std::memory_order_relaxed) == k) {
+                    noeuds[l.id].pere = l.pere;
+                    noeuds[l.id].mere = l.mere;
+                }
+        });
+    }
+    std::vector<std::vector<Lien>>().swap(liens);
+
+    // compte des enfants et fratries, construits d'un bloc une fois tous les liens posés
+    recompterEnfants();
+}
+
+//--------------------------------------------------------------------
+void Ancetres::lireIndividus(const char * deb, const char * fin,
+                             std::vector<Noeud> & nds, std::vector<std::string> & nomsLus)
+{
+    std::unordered_map<std::string,std::uint32_t> nomTOlu; // internement local au morceau
+    const char * p = deb;
+    while ( p < fin )
+    {
+        // déchiffrage des données, directement dans le tampon
+        char sexe = *p;
+        const char * nom = sauterBlancs(p+1,fin), * finNom = finMot(nom,fin);
+        const char * date = sauterBlancs(finNom,fin), * finDate = finMot(date,fin);
+        auto res = nomTOlu.emplace(std::string(nom,finNom),(std::uint32_t)nomsLus.size());
+        if (res.second)
+            nomsLus.push_back(res.first->first);
+        nds.push_back(Noeud{sexe, res.first->second,
+                            Individu::coderDate(date,(std::size_t)(finDate-date)), -1, -1});
+        p = ligneSuivante(finDate,fin); // prochaine ligne
+    }
+}
+
+//--------------------------------------------------------------------
+void Ancetres::lireLiens(const char * deb, const char * fin, std::size_t nbNoeuds, std::vector<Lien> & liens)
+{
+    const char * p = deb;
+    while ( p < fin )
+    {
+        const char * q = p;
+        unsigned int i = lireEntier(q,fin); // numéro de l'individu
+        if ( i != 0 )
         {
-            mer = noeuds.at(m-1).ind;
-            this->setMere(ind,mer);
+            unsigned int per = lireEntier(q,fin), mer = lireEntier(q,fin); // numéros de son père, sa mère
+            if (i > nbNoeuds or per > nbNoeuds or mer > nbNoeuds)
+                throw std::out_of_range("numéro d'individu inconnu dans la ligne de liens de " + std::to_string(i));
+            liens.push_back(Lien{(PersonId)i-1, (int)per-1, (int)mer-1}); // -1 si inconnu
+        }
+        p = ligneSuivante(q,fin); // prochaine ligne
+    }
+}
+
+//--------------------------------------------------------------------
+// Instantané binaire : un en-tête, puis des tableaux alignés sur 8 octets, dans l'ordre
+//   débuts des noms (uint32 x nbNoms+1), caractères des noms mis bout à bout (char x nbCar), individus ({nom, clé} uint32 x 2 x nbNoeuds),
+//   pères (int32 x nbNoeuds), mères (int32 x nbNoeuds), cases de indTOnd, cases de nomTOid,
+//   rangs d'origine (uint32 x nbOrigines, 0 ou nbNoeuds, voir renumeroter)
+
+// version du format, à incrémenter à chaque changement de disposition
+static const std::uint32_t VERSION_INSTANTANE = 2;
+// marque d'ordre des octets : relue différemment sur une machine de boutisme opposé
+static const std::uint32_t ORDRE_INSTANTANE = 0x01020304u;
+
+// en-tête d'un instantané
+struct EnTeteInstantane
+{
+    char magique[8]; // "ANCETRES"
+    std::uint32_t version, ordre;
+    std::uint64_t nbNoeuds, nbNoms, nbCar, nbCasesInd, nbInd, nbCasesNoms, nbOrigines;
+};
+
+// arrondit une taille au multiple de 8 supérieur
+static std::size_t aligner(std::size_t n)
+{
+    return (n+7) & ~(std::size_t)7;
+}
+
+// écrit les octets qui complètent un tableau de lg octets jusqu'à l'alignement
+static void bourrer(std::ostream & f, std::size_t lg)
+{
+    static const char zeros[8] = {0};
+    f.write(zeros, (std::streamsize)(aligner(lg)-lg));
+}
+
+// écrit un tableau segmenté, segment par segment, suivi du bourrage d'alignement
+template<class T, unsigned int BITS>
+static void ecrireSegments(std::ostream & f, const Segments<T,BITS> & s)
+{
+    for (std::size_t k = 0; k < s.nbSegments(); ++k)
+        f.write(reinterpret_cast<const char *>(s.segment(k)), (std::streamsize)(s.tailleSegment(k)*sizeof(T)));
+    bourrer(f, s.size()*sizeof(T));
+}
+
+//--------------------------------------------------------------------
+bool Ancetres::sauvegarder(const std::string & fic) const
+{
+    std::ofstream f(fic, std::ios::binary | std::ios::trunc);
+    if (!f.is_open())
+        return false;
+
+    EnTeteInstantane et;
+    std::memcpy(et.magique, "ANCETRES", 8);
+    et.version = VERSION_INSTANTANE;
+    et.ordre = ORDRE_INSTANTANE;
+    // les noms sont écrits bout à bout, sans les trous qui gardent chacun dans un seul segment
+    std::vector<std::uint32_t> debuts(noms.size()+1, 0);
+    for (std::size_t i = 0; i < noms.size(); ++i)
+        debuts[i+1] = debuts[i] + noms[i].lg;
+    et.nbNoeuds = noeuds.size();
+    et.nbNoms = noms.size();
+    et.nbCar = debuts.back();
+    et.nbCasesInd = indTOnd.cases().size();
+    et.nbInd = indTOnd.taille();
+    et.nbCasesNoms = nomTOid.cases().size();
+    et.nbOrigines = origine.size();
+    f.write(reinterpret_cast<const char *>(&et), sizeof et);
+
+    // écriture d'un tableau suivie du bourrage d'alignement
+    auto ecrire = [&f](const void * p, std::size_t lg) {
+        if (lg > 0)
+            f.write(static_cast<const char *>(p), (std::streamsize)lg);
+        bourrer(f, lg);
+    };
+    ecrire(debuts.data(), debuts.size()*sizeof(std::uint32_t));
+    for (std::uint32_t i = 0; i < noms.size(); ++i)
+        f.write(caracteres(i), (std::streamsize)noms[i].lg);
+    bourrer(f, et.nbCar);
+
+    // la table des individus, puis les parents, dans des tableaux séparés
+    std::vector<std::uint32_t> inds(2*noeuds.size());
+    std::vector<std::int32_t> peres(noeuds.size()), meres(noeuds.size());
+    for (std::size_t i = 0; i < noeuds.size(); ++i)
+    {
+        inds[2*i] = noeuds[i].nom;
+        inds[2*i+1] = noeuds[i].date<<8 | (unsigned char)noeuds[i].sexe;
+        peres[i] = noeuds[i].pere;
+        meres[i] = noeuds[i].mere;
+    }
+    ecrire(inds.data(), inds.size()*sizeof(std::uint32_t));
+    ecrire(peres.data(), peres.size()*sizeof(std::int32_t));
+    ecrire(meres.data(), meres.size()*sizeof(std::int32_t));
+
+    ecrireSegments(f, indTOnd.cases());
+    ecrireSegments(f, nomTOid.cases());
+    ecrireSegments(f, origine);
+    return f.good();
+}
+
+//--------------------------------------------------------------------
+bool Ancetres::charger(const std::string & fic)
+{
+    Projection proj(fic);
+    if (!proj.ouverte() or proj.taille() < sizeof(EnTeteInstantane))
+        return false;
+    EnTeteInstantane et;
+    std::memcpy(&et, proj.donnees(), sizeof et);
+    if (std::memcmp(et.magique, "ANCETRES", 8) != 0 or et.version != VERSION_INSTANTANE
+        or et.ordre != ORDRE_INSTANTANE or (et.nbOrigines != 0 and et.nbOrigines != et.nbNoeuds))
+        return false;
+    // chaque compte est borné par la taille du fichier, ce qui écarte les débordements dans le calcul des bornes,
+    // et les parents (int32), indices de noms et positions dans la table des noms tiennent sur 32 bits
+    std::uint64_t taille = proj.taille();
+    if (et.nbNoeuds > taille or et.nbNoms > taille or et.nbCar > taille or et.nbCasesInd > taille or et.nbCasesNoms > taille
+        or et.nbNoeuds > 0x7FFFFFFFu or et.nbNoms >= TableIds::VIDE or et.nbCar > 0xFFFFFFFFu)
+        return false;
+
+    // bornes de chaque tableau dans le fichier
+    std::size_t lgNomsDebut = (std::size_t)(et.nbNoms+1)*sizeof(std::uint32_t);
+    std::size_t lgInds = (std::size_t)et.nbNoeuds*2*sizeof(std::uint32_t);
+    std::size_t lgParents = (std::size_t)et.nbNoeuds*sizeof(std::int32_t);
+    std::size_t attendu = sizeof et + aligner(lgNomsDebut) + aligner((std::size_t)et.nbCar) + aligner(lgInds)
+                        + 2*aligner(lgParents) + (std::size_t)(et.nbCasesInd+et.nbCasesNoms)*sizeof(TableIds::Case)
+                        + (std::size_t)et.nbOrigines*sizeof(PersonId);
+    if (proj.taille() < attendu)
+        return false;
+
+    // repérage de chaque tableau et passage au suivant
+    const char * p = proj.donnees() + sizeof et;
+    auto suivant = [&p](std::size_t lg) {
+        const char * t = p;
+        p += aligner(lg);
+        return t;
+    };
+    std::size_t nbNoeudsLus = (std::size_t)et.nbNoeuds, nbNomsLus = (std::size_t)et.nbNoms;
+    const std::uint32_t * debuts = reinterpret_cast<const std::uint32_t *>(suivant(lgNomsDebut));
+    const char * car = suivant((std::size_t)et.nbCar);
+    const std::uint32_t * inds = reinterpret_cast<const std::uint32_t *>(suivant(lgInds));
+    const std::int32_t * peres = reinterpret_cast<const std::int32_t *>(suivant(lgParents));
+    const std::int32_t * meres = reinterpret_cast<const std::int32_t *>(suivant(lgParents));
+    const TableIds::Case * casesInd = reinterpret_cast<const TableIds::Case *>(suivant((std::size_t)et.nbCasesInd*sizeof(TableIds::Case)));
+    const TableIds::Case * casesNoms = reinterpret_cast<const TableIds::Case *>(suivant((std::size_t)et.nbCasesNoms*sizeof(TableIds::Case)));
+    const PersonId * origines = reinterpret_cast<const PersonId *>(p);
+
+    // vérification de tout ce qui sert d'indice, avant de toucher à la forêt : un instantané abîmé est refusé
+    if (debuts[0] != 0 or debuts[nbNomsLus] != et.nbCar)
+        return false;
+    for (std::size_t i = 0; i < nbNomsLus; ++i)
+        if (debuts[i+1] < debuts[i] or debuts[i+1]-debuts[i] > NOM_MAX)
+            return false;
+    for (std::size_t i = 0; i < nbNoeudsLus; ++i)
+        if (inds[2*i] >= nbNomsLus or peres[i] < -1 or peres[i] >= (std::int64_t)nbNoeudsLus
+            or meres[i] < -1 or meres[i] >= (std::int64_t)nbNoeudsLus)
+            return false;
+    // une table de recherche : 0 case pour 0 identifiant, sinon une puissance de 2 de cases, dont il reste au moins une libre,
+    // et exactement nb cases occupées par des identifiants valides
+    auto tableValide = [](const TableIds::Case * c, std::uint64_t nbCases, std::uint64_t nb, std::uint64_t borne) {
+        if (nbCases == 0)
+            return nb == 0;
+        if ((nbCases & (nbCases-1)) != 0 or nbCases <= nb)
+            return false;
+        std::uint64_t occupees = 0;
+        for (std::size_t i = 0; i < nbCases; ++i)
+            if (c[i].id != TableIds::VIDE) {
+                if (c[i].id >= borne)
+                    return false;
+                ++occupees;
+            }
+        return occupees == nb;
+    };
+    if (et.nbInd != et.nbNoeuds or !tableValide(casesInd, et.nbCasesInd, et.nbInd, et.nbNoeuds)
+        or !tableValide(casesNoms, et.nbCasesNoms, et.nbNoms, et.nbNoms))
+        return false;
+    if (et.nbOrigines != 0) { // une permutation des identifiants
+        std::vector<bool> vu(nbNoeudsLus, false);
+        for (std::size_t i = 0; i < nbNoeudsLus; ++i) {
+            if (origines[i] >= nbNoeudsLus or vu[origines[i]])
+                return false;
+            vu[origines[i]] = true;
         }
-        std::getline(f,ligne); // prochaine ligne
     }
-    f.close();
+
+    // lecture : simples recopies, les noms replacés chacun dans un seul segment
+    nomsCar.clear();
+    noms.clear();
+    noms.reserve(nbNomsLus);
+    for (std::size_t i = 0; i < nbNomsLus; ++i)
+        noms.push_back(rangerNom(car + debuts[i], debuts[i+1]-debuts[i]));
+    noeuds.clear();
+    noeuds.reserve(nbNoeudsLus);
+    for (std::size_t i = 0; i < nbNoeudsLus; ++i)
+        noeuds.push_back(Noeud{(char)(inds[2*i+1] & 0xFF), inds[2*i], inds[2*i+1]>>8, peres[i], meres[i]});
+    indTOnd.restaurer(casesInd, (std::size_t)et.nbCasesInd, (std::size_t)et.nbInd);
+    nomTOid.restaurer(casesNoms, (std::size_t)et.nbCasesNoms, (std::size_t)et.nbNoms);
+    origine.clear();
+    origine.ajouter(origines, (std::size_t)et.nbOrigines);
+    idsOrigine.resize(origine.size());
+    for (PersonId id = 0; id < origine.size(); ++id)
+        idsOrigine[origine[id]] = id;
+    numeroEspace = Espace(); // les identifiants d'avant le chargement ne désignent plus les mêmes individus
+    recompterEnfants();
+    generationsAJour = false;
+    return true;
 }
 
 //--------------------------------------------------------------------
 void Ancetres::afficher(std::ostream & os) const
-{ // affichage formaté des individus, puis de leurs liens de filiation
+{ // affichage formaté des individus, puis de leurs liens de filiation, au format lu par le constructeur
+    TamponSortie t(os);
 
-    // affichage des individus
-    for ( auto & nd : noeuds )
+    // affichage des individus, noms lus sur place dans la table des noms
+    for ( std::size_t rang = 0 ; rang < noeuds.size() ; ++ rang )
     {
-        os << nd.ind << std::endl;
+        const Noeud & nd = noeuds[identifiantOrigine((PersonId)rang)];
+        t.individu(nd.sexe, caracteres(nd.nom), noms[nd.nom].lg, nd.date);
+        t.caractere('\n');
     }
 
-    // affichage des liens de filiation
-    for ( size_t i = 0 ; i < noeuds.size() ; ++ i )
+    // affichage des liens de filiation, par rang d'origine, 0 pour un parent inconnu
+    for ( std::size_t rang = 0 ; rang < noeuds.size() ; ++ rang )
     {
-        os << i+1 << '\t' << noeuds.at(i).pere+1 << '\t' << noeuds.at(i).mere+1 << std::endl;
+        const Noeud & nd = noeuds[identifiantOrigine((PersonId)rang)];
+        t.entier(rang+1);
+        t.caractere('\t');
+        t.entier(nd.pere == -1 ? 0 : (std::uint64_t)numeroOrigine((PersonId)nd.pere)+1);
+        t.caractere('\t');
+        t.entier(nd.mere == -1 ? 0 : (std::uint64_t)numeroOrigine((PersonId)nd.mere)+1);
+        t.caractere('\n');
+    }
+}
+
+//--------------------------------------------------------------------
+void Ancetres::exporter(std::ostream & os, char separateur) const
+{
+    TamponSortie t(os);
+    const char * const ENTETE[] = {"numero", "sexe", "nom", "date", "pere", "mere"};
+    for (std::size_t k = 0; k < 6; ++k) {
+        if (k > 0)
+            t.caractere(separateur);
+        t.texte(ENTETE[k], std::strlen(ENTETE[k]));
+    }
+    t.caractere('\n');
+    for (std::size_t i = 0; i < noeuds.size(); ++i) {
+        const Noeud & nd = noeuds[identifiantOrigine((PersonId)i)];
+        const char * nom = caracteres(nd.nom);
+        std::size_t lg = noms[nd.nom].lg;
+        t.entier(i+1);
+        t.caractere(separateur);
+        t.caractere(nd.sexe);
+        t.caractere(separateur);
+        // un nom qui contient le séparateur ou un guillemet est cité, ses guillemets doublés
+        bool citer = false;
+        for (std::size_t k = 0; k < lg and !citer; ++k)
+            citer = nom[k] == separateur or nom[k] == '"';
+        if (citer) {
+            t.caractere('"');
+            for (std::size_t k = 0; k < lg; ++k) {
+                if (nom[k] == '"')
+                    t.caractere('"');
+                t.caractere(nom[k]);
+            }
+            t.caractere('"');
+        } else
+            t.texte(nom, lg);
+        t.caractere(separateur);
+        t.date(nd.date);
+        t.caractere(separateur);
+        if (nd.pere >= 0)
+            t.entier((std::uint64_t)numeroOrigine((PersonId)nd.pere)+1);
+        t.caractere(separateur);
+        if (nd.mere >= 0)
+            t.entier((std::uint64_t)numeroOrigine((PersonId)nd.mere)+1);
+        t.caractere('\n');
     }
 }
 
 //--------------------------------------------------------------------
 bool Ancetres::estPresent(const Individu & ind) const
 {
-    return indTOnd.count(ind)>0;
+    return trouver(ind) != TableIds::VIDE;
+}
+
+//--------------------------------------------------------------------
+bool Ancetres::estPresent(char sexe, const char * nom, std::size_t lgNom, const char * date) const
+{
+    return trouver(sexe, nom, lgNom, Individu::coderDate(date,10)) != TableIds::VIDE;
 }
 
 //--------------------------------------------------------------------
-void Ancetres::ajouter(const Individu & ind)
+std::uint64_t Ancetres::hacher(std::uint32_t nom, std::uint32_t cle)
 {
-    noeuds.push_back(Noeud{ind, -1, -1});
-    indTOnd.emplace(ind,(unsigned int)noeuds.size()-1);
+    return TableIds::melanger((std::uint64_t)nom<<32 | cle);
 }
 
 //--------------------------------------------------------------------
-bool Ancetres::hasPere(Individu ind) const
+std::uint32_t Ancetres::trouverNom(const char * nom, std::size_t lg) const
 {
-    bool hp = false;
-    if (noeuds.at(indTOnd.at(ind)).pere != -1)
-      hp = true;
-    return hp;
+    return nomTOid.trouver(TableIds::hacher(nom,lg), [&](std::uint32_t i) {
+        return noms[i].lg == lg and std::memcmp(caracteres(i),nom,lg) == 0;
+    });
+}
+
+//--------------------------------------------------------------------
+std::uint32_t Ancetres::interner(const char * nom, std::size_t lg)
+{
+    if (lg > NOM_MAX)
+        throw std::length_error("nom de plus de " + std::to_string(NOM_MAX) + " caractères");
+    std::uint32_t i = (std::uint32_t)noms.size(); // indice du nom s'il est nouveau
+    const Ancetres & lue = *this; // les noms comparés sont lus sans dupliquer leurs segments
+    std::uint32_t res = nomTOid.inserer(TableIds::hacher(nom,lg), i, [&](std::uint32_t j) {
+        return lue.noms[j].lg == lg and std::memcmp(lue.caracteres(j),nom,lg) == 0;
+    });
+    if (res == i)
+        noms.push_back(rangerNom(nom, lg));
+    return res;
+}
+
+//--------------------------------------------------------------------
+Ancetres::Nom Ancetres::rangerNom(const char * nom, std::size_t lg)
+{
+    std::size_t debut = nomsCar.size(), reste = NOM_MAX - (debut & (NOM_MAX-1));
+    if (lg > reste) { // le nom commence au segment suivant, le reste du segment courant est perdu
+        nomsCar.resize(debut+reste, '\0');
+        debut += reste;
+    }
+    nomsCar.ajouter(nom, lg);
+    return Nom{(std::uint32_t)debut, (std::uint32_t)lg};
+}
+
+//--------------------------------------------------------------------
+const char * Ancetres::caracteres(std::uint32_t nom) const
+{
+    // un nom vide peut être placé après le dernier caractère rangé
+    return noms[nom].lg == 0 ? "" : &nomsCar[noms[nom].debut];
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::trouver(std::uint32_t nom, std::uint32_t cle) const
+{
+    return indTOnd.trouver(hacher(nom,cle), [&](std::uint32_t id) {
+        const Noeud & nd = noeuds[id];
+        return nd.nom == nom and (nd.date<<8 | (unsigned char)nd.sexe) == cle;
+    });
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::trouver(char sexe, const char * nom, std::size_t lg, std::uint32_t date) const
+{
+    std::uint32_t i = trouverNom(nom,lg);
+    return i == TableIds::VIDE ? TableIds::VIDE : trouver(i, date<<8 | (unsigned char)sexe);
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::trouver(const Individu & ind) const
+{
+    return trouver(ind.sexe, ind.nom.data(), ind.nom.size(), ind.date);
+}
+
+//--------------------------------------------------------------------
+void Ancetres::indexer(PersonId id)
+{
+    const Segments<Noeud> & lus = noeuds;
+    const Noeud & nd = lus[id];
+    std::uint32_t cle = nd.date<<8 | (unsigned char)nd.sexe;
+    indTOnd.inserer(hacher(nd.nom,cle), id, [&](std::uint32_t autre) {
+        return lus[autre].nom == nd.nom and (lus[autre].date<<8 | (unsigned char)lus[autre].sexe) == cle;
+    });
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::ajouter(const Individu & ind)
+{
+    return ajouterNoeud(ind.sexe, interner(ind.nom.data(),ind.nom.size()), ind.date);
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::ajouterNoeud(char sexe, std::uint32_t nom, std::uint32_t date)
+{
+    noeuds.push_back(Noeud{sexe, nom, date, -1, -1});
+    indexer((PersonId)noeuds.size()-1);
+    if (!origine.empty()) {
+        origine.push_back((PersonId)noeuds.size()-1); // rangé après tous les autres, comme dans le fichier
+        idsOrigine.push_back((PersonId)noeuds.size()-1);
+    }
+    if (generationsAJour)
+        generations.push_back(0); // sans parents, le nouvel individu est de génération 0
+    fratries.push_back(Fratrie{TableIds::VIDE, TableIds::VIDE, TableIds::VIDE}); // ni enfant, ni parent : aucun chaînage
+    // sans enfant, le nouvel individu est une racine
+    nbEnfants.push_back(0);
+    rangRacine.push_back((std::uint32_t)racinesIds.size());
+    racinesIds.push_back((PersonId)noeuds.size()-1);
+    return (PersonId)noeuds.size()-1;
+}
+
+//--------------------------------------------------------------------
+std::size_t Ancetres::taille() const
+{
+    return noeuds.size();
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::identifiant(const Individu & ind) const
+{
+    PersonId id = trouver(ind);
+    if (id == TableIds::VIDE)
+        throw std::out_of_range("Ancetres::identifiant : individu absent de la forêt");
+    return id;
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::identifiant(char sexe, const char * nom, std::size_t lgNom, const char * date) const
+{
+    PersonId id = trouver(sexe, nom, lgNom, Individu::coderDate(date,10));
+    if (id == TableIds::VIDE)
+        throw std::out_of_range("Ancetres::identifiant : individu absent de la forêt");
+    return id;
+}
+
+//--------------------------------------------------------------------
+Individu Ancetres::individu(PersonId id) const
+{
+    const Noeud & nd = noeuds[id];
+    Individu ind;
+    ind.sexe = nd.sexe;
+    ind.nom.assign(caracteres(nd.nom), noms[nd.nom].lg);
+    ind.date = nd.date;
+    return ind;
+}
+
+//--------------------------------------------------------------------
+bool Ancetres::hasPere(const Individu & ind) const
+{
+    return hasPere(identifiant(ind));
+}
+
+//--------------------------------------------------------------------
+bool Ancetres::hasPere(PersonId id) const
+{
+    return noeuds[id].pere != -1;
 }
         
 //--------------------------------------------------------------------
-Individu Ancetres::getPere(Individu ind) const
+Individu Ancetres::getPere(const Individu & ind) const
 {
-    Individu p;
-    p = noeuds.at(noeuds.at(indTOnd.at(ind)).pere).ind;
-    return p;
+    return individu(getPere(identifiant(ind)));
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::getPere(PersonId id) const
+{
+    return (PersonId)noeuds[id].pere;
 }
         
 //--------------------------------------------------------------------
-void Ancetres::setPere(Individu ind, Individu pere)
+void Ancetres::setPere(const Individu & ind, const Individu & pere)
+{
+    setPere(identifiant(ind), identifiant(pere));
+}
+
+//--------------------------------------------------------------------
+void Ancetres::setPere(PersonId id, PersonId pere)
+{
+    // un parent qui est à la fois père et mère ne compte l'enfant qu'une fois, et ne le chaîne que du côté du père :
+    // la mère qui était ou devient aussi le père change de côté
+    Noeud & nd = noeuds[id];
+    int ancien = nd.pere, mere = nd.mere;
+    if (ancien != -1)
+        delierEnfant((PersonId)ancien, id);
+    if (mere != -1 && mere != ancien && mere == (int)pere)
+        delierEnfant((PersonId)mere, id);
+    if (ancien != -1 && ancien != mere)
+        perdreEnfant((PersonId)ancien);
+    nd.pere = (int)pere;
+    lierEnfant(pere, id);
+    if (mere != -1 && mere == ancien && mere != (int)pere)
+        lierEnfant((PersonId)mere, id);
+    if (nd.pere != nd.mere)
+        gagnerEnfant(pere);
+    propagerGeneration(id);
+}
+
+//--------------------------------------------------------------------
+bool Ancetres::hasMere(const Individu & ind) const
 {
-    noeuds.at(indTOnd.at(ind)).pere = indTOnd.at(pere);
+    return hasMere(identifiant(ind));
 }
 
 //--------------------------------------------------------------------
-bool Ancetres::hasMere(Individu ind) const
+bool Ancetres::hasMere(PersonId id) const
 {
-    bool hm = false;
-    if (noeuds.at(indTOnd.at(ind)).mere != -1)
-      hm = true;
-    return hm;
+    return noeuds[id].mere != -1;
 }
         
 //--------------------------------------------------------------------
-Individu Ancetres::getMere(Individu ind) const
+Individu Ancetres::getMere(const Individu & ind) const
 {
-    Individu m;
-    m = noeuds.at(noeuds.at(indTOnd.at(ind)).mere).ind;
-    return m;
+    return individu(getMere(identifiant(ind)));
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::getMere(PersonId id) const
+{
+    return (PersonId)noeuds[id].mere;
 }
         
 //--------------------------------------------------------------------
-void Ancetres::setMere(Individu ind, Individu mere)
+void Ancetres::setMere(const Individu & ind, const Individu & mere)
+{
+    setMere(identifiant(ind), identifiant(mere));
+}
+
+//--------------------------------------------------------------------
+void Ancetres::setMere(PersonId id, PersonId mere)
 {
-    noeuds.at(indTOnd.at(ind)).mere = indTOnd.at(mere);
+    // une mère qui est aussi le père n'a pas de chaînage propre (voir setPere)
+    Noeud & nd = noeuds[id];
+    if (nd.mere != -1 && nd.mere != nd.pere) {
+        delierEnfant((PersonId)nd.mere, id);
+        perdreEnfant((PersonId)nd.mere);
+    }
+    nd.mere = (int)mere;
+    if (nd.mere != nd.pere) {
+        lierEnfant(mere, id);
+        gagnerEnfant(mere);
+    }
+    propagerGeneration(id);
 }
 
 //--------------------------------------------------------------------
 std::set<Individu> Ancetres::racines() const
 {
     std::set<Individu> rac;
-    std::vector<bool> enfant;
-    for (size_t i=0;i<noeuds.size();++i) enfant.push_back(true);
-    for (Noeud Nds:noeuds) {
-    	if (Nds.pere != -1 && enfant.at(Nds.pere))
-    		enfant.at(Nds.pere) = false;
-    	if (Nds.mere != -1 && enfant.at(Nds.mere))
-    		enfant.at(Nds.mere) = false;
-    }
-    for (size_t i=0;i<enfant.size();++i)
-    	if (enfant.at(i))
-    		rac.emplace(noeuds.at(i).ind);
+    for (PersonId id : idsRacines())
+    	rac.emplace(individu(id));
     return rac;
 }
 
+//--------------------------------------------------------------------
+const Segments<PersonId> & Ancetres::idsRacines() const
+{
+    return racinesIds;
+}
+
+//--------------------------------------------------------------------
+std::size_t Ancetres::nbRacines() const
+{
+    return racinesIds.size();
+}
+
+//--------------------------------------------------------------------
+std::size_t Ancetres::nombreEnfants(PersonId id) const
+{
+    return nbEnfants[id];
+}
+
+//--------------------------------------------------------------------
+void Ancetres::gagnerEnfant(PersonId par)
+{
+    if (nbEnfants[par]++ == 0) {
+        // retrait de racinesIds : le dernier prend sa place
+        PersonId dernier = racinesIds.back();
+        racinesIds[rangRacine[par]] = dernier;
+        rangRacine[dernier] = rangRacine[par];
+        racinesIds.pop_back();
+        rangRacine[par] = TableIds::VIDE;
+    }
+}
+
+//--------------------------------------------------------------------
+void Ancetres::perdreEnfant(PersonId par)
+{
+    if (--nbEnfants[par] == 0) {
+        rangRacine[par] = (std::uint32_t)racinesIds.size();
+        racinesIds.push_back(par);
+    }
+}
+
+//--------------------------------------------------------------------
+void Ancetres::recompterEnfants()
+{
+    nbEnfants.assign(noeuds.size(), 0);
+    for (const Noeud & nd : noeuds) {
+    	if (nd.pere != -1)
+    		++nbEnfants[nd.pere];
+    	if (nd.mere != -1 && nd.mere != nd.pere)
+    		++nbEnfants[nd.mere];
+    }
+    // par identifiant décroissant, chaque enfant devient l'aîné de ses parents : les fratries sortent triées
+    fratries.assign(noeuds.size(), Fratrie{TableIds::VIDE, TableIds::VIDE, TableIds::VIDE});
+    for (PersonId id = (PersonId)noeuds.size(); id-- > 0; ) {
+    	const Noeud & nd = static_cast<const Segments<Noeud> &>(noeuds)[id];
+    	if (nd.pere != -1) {
+    		fratries[id].cadetPere = fratries[nd.pere].aine;
+    		fratries[nd.pere].aine = id;
+    	}
+    	if (nd.mere != -1 && nd.mere != nd.pere) {
+    		fratries[id].cadetMere = fratries[nd.mere].aine;
+    		fratries[nd.mere].aine = id;
+    	}
+    }
+    racinesIds.clear();
+    rangRacine.assign(noeuds.size(), TableIds::VIDE);
+    for (PersonId id = 0; id < noeuds.size(); ++id)
+    	if (nbEnfants[id] == 0) {
+    		rangRacine[id] = (std::uint32_t)racinesIds.size();
+    		racinesIds.push_back(id);
+    	}
+}
+
 //--------------------------------------------------------------------
 std::set<Individu> Ancetres::individus() const
 {
     std::set<Individu> inds;
-    for (Noeud Nds:noeuds)
-    	if (inds.count(Nds.ind) == 0)
-    		inds.emplace(Nds.ind);
+    for (PersonId id : idsIndividus())
+    	inds.emplace(individu(id));
     return inds;
 }
 
 //--------------------------------------------------------------------
-Ancetres Ancetres::ancetresCommuns(Individu ind1, Individu ind2) const
-{
-    Ancetres com;
-    size_t indice = 0;
-    //création d'un tableau contenant les indices des ancètres
-    std::vector<int> Anc1;
-    //Ajout de l'individu pour lancer la boucle
-    Anc1.push_back(indTOnd.at(ind1));
-    //Tant que tous les ancètres n'ont pas été parcouru
-    while (indice <= Anc1.size()-1) {
-    	//Ajout du père si existant
-    	if (noeuds.at(Anc1.at(indice)).pere != -1)
-    		Anc1.push_back(noeuds.at(Anc1.at(indice)).pere);
-    	//Ajout de la mère si existante
-    	if (noeuds.at(Anc1.at(indice)).mere != -1)
-    		Anc1.push_back(noeuds.at(Anc1.at(indice)).mere);
-    	indice++;
-    }
-    //Réinitialisation de l'indice pour la seconde boucle
-    indice = 0;
-    std::vector<int> Anc2;
-    //Ajout de l'individu pour lancer la boucle
-    Anc2.push_back(indTOnd.at(ind2));
-    while (indice <= Anc2.size()-1) {
-    	if (noeuds.at(Anc2.at(indice)).pere != -1)
-    		Anc2.push_back(noeuds.at(Anc2.at(indice)).pere);
-    	if (noeuds.at(Anc2.at(indice)).mere != -1)
-    		Anc2.push_back(noeuds.at(Anc2.at(indice)).mere);
-    	indice++;
-    }
-    /*Parcours des vecteurs, ajouts de tous les ancètres communs aux deux sans doublons*/
-    for (int i = (int)Anc1.size()-1; i >= 0; --i) {
-    	for (int j = (int)Anc2.size()-1; j >= 0; --j) {
-    		if (Anc2.at(j)==Anc1.at(i)) {
-    			if (!com.estPresent(noeuds.at(Anc1.at(i)).ind)) {
-    				com.ajouter(noeuds.at(Anc1.at(i)).ind);
+PlageIds Ancetres::idsIndividus() const
+{
+    return PlageIds{0, (PersonId)noeuds.size()};
+}
+
+//--------------------------------------------------------------------
+VueIndividu Ancetres::vue(PersonId id) const
+{
+    const Noeud & nd = noeuds[id];
+    return VueIndividu{id, nd.sexe, caracteres(nd.nom), noms[nd.nom].lg, nd.date};
+}
+
+//--------------------------------------------------------------------
+Ancetres Ancetres::ancetresCommuns(const Individu & ind1, const Individu & ind2) const
+{
+    return ancetresCommuns(identifiant(ind1), identifiant(ind2));
+}
+
+//--------------------------------------------------------------------
+Ancetres Ancetres::ancetresCommuns(PersonId id1, PersonId id2) const
+{
+    return ancetresCommuns(id1, id2, marquageDuFil());
+}
+
+//--------------------------------------------------------------------
+Ancetres::Marquage & Ancetres::marquageDuFil()
+{
+    // durée de vie d'un fil : initialisé à zéro, donc à l'époque 0, avant sa construction
+    static thread_local Marquage m;
+    return m;
+}
+
+//--------------------------------------------------------------------
+std::vector<Ancetres> Ancetres::ancetresCommuns(const std::vector<std::pair<PersonId,PersonId>> & paires) const
+{
+    std::vector<Ancetres> res;
+    res.reserve(paires.size());
+    Marquage m;
+    m.epoque = 0;
+    for (const std::pair<PersonId,PersonId> & p : paires)
+        res.push_back(ancetresCommuns(p.first, p.second, m));
+    return res;
+}
+
+//--------------------------------------------------------------------
+Ancetres Ancetres::ancetresCommuns(PersonId id1, PersonId id2, Marquage & m) const
+{
+    // trois époques par requête : vu depuis id1 seul, depuis id2 seul, depuis les deux
+    const std::uint32_t vu1 = preparer(m,3), vu2 = vu1+1, vu12 = vu1+2;
+
+    // parcours en largeur des ancêtres de id1, chacun visité une seule fois
+    m.file1.clear();
+    m.file1.push_back(id1);
+    m.marque[id1] = vu1;
+    for (std::size_t i = 0; i < m.file1.size(); ++i) {
+    	const Noeud & nd = noeuds[m.file1[i]];
+    	if (nd.pere != -1 && m.marque[nd.pere] != vu1) {
+    		m.marque[nd.pere] = vu1;
+    		m.file1.push_back((PersonId)nd.pere);
+    	}
+    	if (nd.mere != -1 && m.marque[nd.mere] != vu1) {
+    		m.marque[nd.mere] = vu1;
+    		m.file1.push_back((PersonId)nd.mere);
+    	}
+    }
+
+    // parcours des ancêtres de id2 : ceux déjà vus depuis id1 sont communs
+    m.file2.clear();
+    m.file2.push_back(id2);
+    m.marque[id2] = m.marque[id2] == vu1 ? vu12 : vu2;
+    for (std::size_t i = 0; i < m.file2.size(); ++i) {
+    	const Noeud & nd = noeuds[m.file2[i]];
+    	for (int par : {nd.pere, nd.mere}) {
+    		if (par != -1 && m.marque[par] != vu2 && m.marque[par] != vu12) {
+    			m.marque[par] = m.marque[par] == vu1 ? vu12 : vu2;
+    			m.file2.push_back((PersonId)par);
+    		}
+    	}
+    }
+
+    // les parents d'un ancêtre commun sont eux aussi communs : tous les liens sont recopiés
+    return extraire(m.file1, m, vu12);
+}
+
+//--------------------------------------------------------------------
+Ancetres Ancetres::extraire(const std::vector<PersonId> & parcours, Marquage & m, std::uint32_t vu) const
+{
+    /*Ajout des nœuds retenus, des plus anciens (fin du parcours) aux plus récents,
+      puis liens de filiation entre nœuds retenus*/
+    std::size_t nbRetenus = 0;
+    for (PersonId id : parcours)
+    	nbRetenus += m.marque[id] == vu;
+    Ancetres res;
+    res.noeuds.reserve(nbRetenus);
+    res.indTOnd.reserver(nbRetenus);
+    for (std::size_t i = parcours.size(); i-- > 0; ) {
+    	PersonId id = parcours[i];
+    	if (m.marque[id] == vu) {
+    		// recopie directe du nœud : le nom est interné depuis la table des noms, sans chaîne intermédiaire
+    		const Noeud & nd = noeuds[id];
+    		res.noeuds.push_back(Noeud{nd.sexe, res.interner(caracteres(nd.nom), noms[nd.nom].lg), nd.date, -1, -1});
+    		m.rang[id] = (PersonId)res.noeuds.size()-1;
+    		res.indexer(m.rang[id]);
+    	}
+    }
+    res.recompterEnfants(); // aucun lien encore : tous racines, puis tenus à jour par setPere et setMere
+    for (std::size_t i = parcours.size(); i-- > 0; ) {
+    	PersonId id = parcours[i];
+    	if (m.marque[id] == vu) {
+    		const Noeud & nd = noeuds[id];
+    		if (nd.pere != -1 && m.marque[nd.pere] == vu)
+    			res.setPere(m.rang[id], m.rang[nd.pere]);
+    		if (nd.mere != -1 && m.marque[nd.mere] == vu)
+    			res.setMere(m.rang[id], m.rang[nd.mere]);
+    	}
+    }
+    return res;
+}
+
+//--------------------------------------------------------------------
+Ancetres Ancetres::ancetres(const Individu & ind, unsigned int maxGen) const
+{
+    return ancetres(identifiant(ind), maxGen);
+}
+
+//--------------------------------------------------------------------
+Ancetres Ancetres::ancetres(PersonId id, unsigned int maxGen) const
+{
+    Marquage & m = marquageDuFil();
+    const std::uint32_t vu = preparer(m,1);
+
+    // parcours en largeur, une génération après l'autre, chaque ancêtre visité une seule fois
+    m.file1.clear();
+    m.file1.push_back(id);
+    m.marque[id] = vu;
+    std::size_t debut = 0;
+    for (unsigned int g = 0; g < maxGen and debut < m.file1.size(); ++g) {
+    	std::size_t fin = m.file1.size(); // la génération g occupe file1[debut, fin)
+    	for (std::size_t i = debut; i < fin; ++i) {
+    		const Noeud & nd = noeuds[m.file1[i]];
+    		for (int par : {nd.pere, nd.mere}) {
+    			if (par != -1 && m.marque[par] != vu) {
+    				m.marque[par] = vu;
+    				m.file1.push_back((PersonId)par);
     			}
     		}
     	}
+    	debut = fin;
+    }
+    return extraire(m.file1, m, vu);
+}
+
+//--------------------------------------------------------------------
+void Ancetres::afficherSosa(std::ostream & os, const Individu & ind, unsigned int maxGen) const
+{
+    afficherSosa(os, identifiant(ind), maxGen);
+}
+
+//--------------------------------------------------------------------
+void Ancetres::afficherSosa(std::ostream & os, PersonId id, unsigned int maxGen) const
+{
+    TamponSortie t(os);
+    pourChaqueSosa(id, maxGen, [&](std::uint64_t numero, PersonId a, std::uint64_t premier) {
+        const Noeud & nd = noeuds[a];
+        t.entier(numero);
+        t.caractere('\t');
+        t.individu(nd.sexe, caracteres(nd.nom), noms[nd.nom].lg, nd.date);
+        if (premier != numero) {
+            t.texte("\t= ", 3);
+            t.entier(premier);
+        }
+        t.caractere('\n');
+    });
+}
+
+//--------------------------------------------------------------------
+std::uint32_t Ancetres::preparer(Marquage & m, std::uint32_t nbEpoques) const
+{
+    // mise à la taille de la forêt, remise à zéro seulement quand les époques s'épuisent
+    if (m.marque.size() < noeuds.size())
+    {
+        m.marque.resize(noeuds.size(), 0);
+        m.marqueBis.resize(noeuds.size(), 0);
+        m.rang.resize(noeuds.size());
+        m.dist1.resize(noeuds.size());
+        m.dist2.resize(noeuds.size());
     }
-    /*Parcours du vecteur noeuds du nouvel arbre d'ancètres
-	    com.noeuds.at(i).ind est l'individu du nouvel arbre à la position i
-  	  noeuds.at(indTOnd.at(ind)).pere récupère l'indice du père dans l'ancien arbre
-  	  noeuds.at(pere).ind) récupère l'individu père dans l'ancien arbre
-  	MEME PRINCIPE POUR LA MERE*/
-    for (size_t i = 0; i < com.noeuds.size();++i) {
-    	if (noeuds.at(indTOnd.at(com.noeuds.at(i).ind)).pere != -1)
-    		com.setPere(com.noeuds.at(i).ind, noeuds.at(noeuds.at(indTOnd.at(com.noeuds.at(i).ind)).pere).ind);
-    	if (noeuds.at(indTOnd.at(com.noeuds.at(i).ind)).mere != -1)
-    		com.setMere(com.noeuds.at(i).ind, noeuds.at(noeuds.at(indTOnd.at(com.noeuds.at(i).ind)).mere).ind);
+    if (m.epoque > 0xFFFFFFFFu - nbEpoques)
+    {
+        std::fill(m.marque.begin(), m.marque.end(), 0);
+        std::fill(m.marqueBis.begin(), m.marqueBis.end(), 0);
+        m.epoque = 0;
     }
-    return com;
+    m.epoque += nbEpoques;
+    return m.epoque - nbEpoques + 1;
 }
 
 //--------------------------------------------------------------------
-void Ancetres::fusion(Ancetres anc)
+void Ancetres::calculerGenerations() const
 {
-    for (Noeud Nds:anc.noeuds)
-    	if (!estPresent(Nds.ind))
-    		ajouter(Nds.ind);
-    for (int i = (int)noeuds.size()-1;i>=0;--i) {
-    	if (!hasMere(noeuds.at(i).ind))
-    		if (anc.estPresent(noeuds.at(i).ind) && anc.hasMere(noeuds.at(i).ind))
-    			setMere(noeuds.at(i).ind, anc.getMere(noeuds.at(i).ind));
-    	if (!hasPere(noeuds.at(i).ind))
-    		if (anc.estPresent(noeuds.at(i).ind) && anc.hasPere(noeuds.at(i).ind))
-    			setPere(noeuds.at(i).ind, anc.getPere(noeuds.at(i).ind));
+    if (generationsAJour)
+        return;
+    // parcours en profondeur itératif : un nœud est terminé quand ses deux parents le sont
+    // etat : 0 = non visité, 1 = en cours, 2 = terminé (un lien vers un nœud en cours, donc un cycle, est ignoré)
+    generations.assign(noeuds.size(), 0);
+    generationsCycle = false;
+    std::vector<unsigned char> etat(noeuds.size(), 0);
+    std::vector<PersonId> pile;
+    for (PersonId racine = 0; racine < noeuds.size(); ++racine) {
+    	if (etat[racine] != 0)
+    		continue;
+    	pile.push_back(racine);
+    	etat[racine] = 1;
+    	while (!pile.empty()) {
+    		PersonId id = pile.back();
+    		const Noeud & nd = noeuds[id];
+    		if (nd.pere != -1 && etat[nd.pere] == 0) {
+    			etat[nd.pere] = 1;
+    			pile.push_back((PersonId)nd.pere);
+    		} else if (nd.mere != -1 && etat[nd.mere] == 0) {
+    			etat[nd.mere] = 1;
+    			pile.push_back((PersonId)nd.mere);
+    		} else {
+    			std::uint32_t g = 0;
+    			if (nd.pere != -1 && etat[nd.pere] == 2)
+    				g = std::max(g, generations[nd.pere]+1);
+    			if (nd.mere != -1 && etat[nd.mere] == 2)
+    				g = std::max(g, generations[nd.mere]+1);
+    			generationsCycle = generationsCycle or (nd.pere != -1 && etat[nd.pere] == 1) or (nd.mere != -1 && etat[nd.mere] == 1);
+    			generations[id] = g;
+    			etat[id] = 2;
+    			pile.pop_back();
+    		}
+    	}
+    }
+    generationsAJour = true;
+}
+
+//--------------------------------------------------------------------
+void Ancetres::propagerGeneration(PersonId id)
+{
+    if (!generationsAJour)
+        return;
+    // un lien ignoré par le calcul complet ne l'est pas ici : la forêt est recalculée d'un bloc tant qu'elle en a
+    if (generationsCycle) {
+        generationsAJour = false;
+        return;
+    }
+    // parcours en largeur des descendants dont la génération change ; un nœud peut y revenir si un autre de ses
+    // parents change ensuite, et autour d'un nouveau cycle les générations croissent sans fin jusqu'à épuiser le budget
+    const Segments<Noeud> & lus = noeuds;
+    const Segments<std::uint32_t> & gens = generations;
+    const std::size_t budget = noeuds.size()/16 + 64;
+    std::vector<PersonId> file(1, id);
+    for (std::size_t i = 0; i < file.size(); ++i) {
+    	if (i == budget) {
+    		generationsAJour = false;
+    		return;
+    	}
+    	PersonId x = file[i];
+    	const Noeud & nd = lus[x];
+    	std::uint32_t g = 0;
+    	if (nd.pere != -1)
+    		g = std::max(g, gens[nd.pere]+1);
+    	if (nd.mere != -1)
+    		g = std::max(g, gens[nd.mere]+1);
+    	if (g == gens[x])
+    		continue;
+    	generations[x] = g;
+    	for (PersonId e : enfants(x))
+    		file.push_back(e);
+    }
+}
+
+//--------------------------------------------------------------------
+PersonId Ancetres::cadet(PersonId enf, PersonId par) const
+{
+    const Fratrie & f = fratries[enf];
+    return noeuds[enf].pere == (int)par ? f.cadetPere : f.cadetMere;
+}
+
+//--------------------------------------------------------------------
+PersonId & Ancetres::lienCadet(PersonId enf, PersonId par)
+{
+    Fratrie & f = fratries[enf];
+    return static_cast<const Segments<Noeud> &>(noeuds)[enf].pere == (int)par ? f.cadetPere : f.cadetMere;
+}
+
+//--------------------------------------------------------------------
+void Ancetres::lierEnfant(PersonId par, PersonId enf)
+{
+    // recherche du prédécesseur en lecture seule, pour ne dupliquer aucun segment des autres enfants
+    const Ancetres & lue = *this;
+    PersonId prec = TableIds::VIDE, suiv = lue.fratries[par].aine;
+    while (suiv != TableIds::VIDE && suiv < enf) {
+    	prec = suiv;
+    	suiv = lue.cadet(suiv, par);
+    }
+    lienCadet(enf, par) = suiv;
+    if (prec == TableIds::VIDE)
+    	fratries[par].aine = enf;
+    else
+    	lienCadet(prec, par) = enf;
+}
+
+//--------------------------------------------------------------------
+void Ancetres::delierEnfant(PersonId par, PersonId enf)
+{
+    const Ancetres & lue = *this;
+    PersonId prec = TableIds::VIDE, x = lue.fratries[par].aine;
+    while (x != enf) {
+    	prec = x;
+    	x = lue.cadet(x, par);
+    }
+    PersonId suiv = lue.cadet(enf, par);
+    if (prec == TableIds::VIDE)
+    	fratries[par].aine = suiv;
+    else
+    	lienCadet(prec, par) = suiv;
+}
+
+//--------------------------------------------------------------------
+VueEnfants Ancetres::enfants(PersonId id) const
+{
+    return VueEnfants{this, id, fratries[id].aine, nbEnfants[id]};
+}
+
+//--------------------------------------------------------------------
+unsigned int Ancetres::generation(PersonId id) const
+{
+    calculerGenerations();
+    // generations est mutable : lu par sa face const, il n'est jamais dupliqué par un lecteur
+    return static_cast<const Segments<std::uint32_t> &>(generations)[id];
+}
+
+//--------------------------------------------------------------------
+std::vector<AncetreCommun> Ancetres::plusProchesAncetresCommuns(const Individu & ind1, const Individu & ind2) const
+{
+    return plusProchesAncetresCommuns(identifiant(ind1), identifiant(ind2));
+}
+
+//--------------------------------------------------------------------
+std::vector<AncetreCommun> Ancetres::plusProchesAncetresCommuns(PersonId id1, PersonId id2) const
+{
+    calculerGenerations();
+    Marquage & m = marquageDuFil();
+    const std::uint32_t vu1 = preparer(m,3), vu2 = vu1+1, vu12 = vu1+2;
+
+    // remontée simultanée depuis les deux individus, une génération de chaque côté à tour de rôle
+    // un nœud atteint des deux côtés est candidat et n'est pas prolongé : ses ancêtres ne sont pas les plus proches
+    std::vector<PersonId> candidats;
+    std::vector<PersonId> & file1 = m.file1, & file2 = m.file2;
+    std::vector<PersonId> suivants;
+    // visite d'un nœud par un côté : vrai s'il faut le prolonger
+    auto visiter = [&](PersonId id, std::uint32_t vu, std::vector<std::uint32_t> & dist, std::uint32_t d) {
+        std::uint32_t autre = vu == vu1 ? vu2 : vu1;
+        if (m.marque[id] == vu or m.marque[id] == vu12)
+            return false;
+        dist[id] = d;
+        if (m.marque[id] == autre) {
+            m.marque[id] = vu12;
+            candidats.push_back(id);
+            return false;
+        }
+        m.marque[id] = vu;
+        return true;
+    };
+    // avance un côté d'une génération
+    auto avancer = [&](std::vector<PersonId> & file, std::uint32_t vu, std::vector<std::uint32_t> & dist, std::uint32_t d) {
+        suivants.clear();
+        for (PersonId id : file) {
+            const Noeud & nd = noeuds[id];
+            if (nd.pere != -1 && visiter((PersonId)nd.pere, vu, dist, d))
+                suivants.push_back((PersonId)nd.pere);
+            if (nd.mere != -1 && visiter((PersonId)nd.mere, vu, dist, d))
+                suivants.push_back((PersonId)nd.mere);
+        }
+        file.swap(suivants);
+    };
+    file1.clear();
+    file2.clear();
+    if (visiter(id1, vu1, m.dist1, 0))
+        file1.push_back(id1);
+    if (visiter(id2, vu2, m.dist2, 0))
+        file2.push_back(id2);
+    for (std::uint32_t d = 1; !file1.empty() or !file2.empty(); ++d) {
+        avancer(file1, vu1, m.dist1, d);
+        avancer(file2, vu2, m.dist2, d);
+    }
+
+    // un candidat ancêtre d'un autre candidat n'est pas parmi les plus proches
+    // remontée depuis les parents des candidats, inutile sous la plus petite génération des candidats
+    const std::uint32_t vuBis = m.epoque;
+    const Segments<std::uint32_t> & gens = generations;
+    std::uint32_t genMin = 0xFFFFFFFFu;
+    for (PersonId c : candidats)
+        genMin = std::min(genMin, gens[c]);
+    std::vector<PersonId> & pile = suivants;
+    pile.clear();
+    for (PersonId c : candidats)
+        for (int par : {noeuds[c].pere, noeuds[c].mere})
+            if (par != -1 && m.marqueBis[par] != vuBis) {
+                m.marqueBis[par] = vuBis;
+                pile.push_back((PersonId)par);
+            }
+    while (!pile.empty()) {
+        PersonId id = pile.back();
+        pile.pop_back();
+        if (gens[id] <= genMin)
+            continue;
+        for (int par : {noeuds[id].pere, noeuds[id].mere})
+            if (par != -1 && m.marqueBis[par] != vuBis) {
+                m.marqueBis[par] = vuBis;
+                pile.push_back((PersonId)par);
+            }
+    }
+
+    std::vector<AncetreCommun> res;
+    for (PersonId c : candidats)
+        if (m.marqueBis[c] != vuBis)
+            res.push_back(AncetreCommun{c, m.dist1[c], m.dist2[c]});
+    std::sort(res.begin(), res.end(), [](const AncetreCommun & a, const AncetreCommun & b) {
+        return a.d1+a.d2 < b.d1+b.d2 or (a.d1+a.d2 == b.d1+b.d2 and a.ancetre < b.ancetre);
+    });
+    return res;
+}
+
+//--------------------------------------------------------------------
+void Ancetres::fusion(const Ancetres & anc)
+{
+    if (&anc == this)
+        return;
+    // correspondance des noms, puis des nœuds de anc vers ceux de l'instance
+    std::vector<std::uint32_t> nomVers(anc.noms.size());
+    for (std::uint32_t i = 0; i < nomVers.size(); ++i)
+    	nomVers[i] = interner(anc.caracteres(i), anc.noms[i].lg);
+    // parcours par rang d'origine : les absents sont ajoutés dans l'ordre du fichier de anc, même renumérotée,
+    // comme lorsque fusion(Ancetres &&) reprend anc dans une instance vide
+    std::vector<PersonId> vers(anc.noeuds.size());
+    for (PersonId rang = 0; rang < vers.size(); ++rang) {
+    	PersonId j = anc.identifiantOrigine(rang);
+    	const Noeud & nd = anc.noeuds[j];
+    	std::uint32_t nom = nomVers[nd.nom];
+    	PersonId id = trouver(nom, nd.date<<8 | (unsigned char)nd.sexe);
+    	vers[j] = id != TableIds::VIDE ? id : ajouterNoeud(nd.sexe, nom, nd.date);
+    }
+    // les liens déjà connus de l'instance sont conservés
+    for (PersonId j = 0; j < vers.size(); ++j) {
+    	const Noeud & nd = anc.noeuds[j];
+    	if (nd.mere != -1 && noeuds[vers[j]].mere == -1)
+    		setMere(vers[j], vers[nd.mere]);
+    	if (nd.pere != -1 && noeuds[vers[j]].pere == -1)
+    		setPere(vers[j], vers[nd.pere]);
+    }
+}
+
+//--------------------------------------------------------------------
+void Ancetres::fusion(Ancetres && anc)
+{
+    if (&anc == this)
+        return;
+    if (noeuds.empty())
+        *this = std::move(anc); // un nouvel espace d'identifiants est tiré (voir Espace)
+    else
+        fusion(static_cast<const Ancetres &>(anc));
+    anc = Ancetres();
+}
+
+//--------------------------------------------------------------------
+// exécute f(i) pour i de 0 à n-1, réparti sur nbTaches fils dont le fil appelant
+template<class Tache>
+static void repartir(std::size_t n, unsigned int nbTaches, Tache f)
+{
+    std::size_t nbFils = std::min<std::size_t>(nbTaches, n);
+    auto boucle = [&f, n, nbFils](std::size_t debut) {
+        for (std::size_t i = debut; i < n; i += nbFils)
+            f(i);
+    };
+    std::vector<std::thread> taches;
+    for (std::size_t t = 1; t < nbFils; ++t)
+        taches.emplace_back(boucle, t);
+    boucle(0);
+    for (std::thread & t : taches)
+        t.join();
+}
+
+//--------------------------------------------------------------------
+Ancetres Ancetres::fusionner(const std::vector<const Ancetres*> & forets, unsigned int nbTaches)
+{
+    if (nbTaches == 0)
+        nbTaches = std::max(1u, std::thread::hardware_concurrency());
+    if (forets.empty())
+        return Ancetres();
+    if (nbTaches == 1 or forets.size() <= 2) {
+        Ancetres res(*forets[0]);
+        for (std::size_t k = 1; k < forets.size(); ++k)
+            res.fusion(*forets[k]);
+        return res;
+    }
+    // premier niveau : chaque paire de forêts voisines est réunie dans une nouvelle forêt ...
+    std::vector<Ancetres> niveau((forets.size()+1)/2);
+    repartir(niveau.size(), nbTaches, [&](std::size_t i) {
+        niveau[i] = *forets[2*i];
+        if (2*i+1 < forets.size())
+            niveau[i].fusion(*forets[2*i+1]);
+    });
+    // ... puis les forêts obtenues sont réunies deux à deux par déplacement, sans recopie
+    while (niveau.size() > 1) {
+        std::vector<Ancetres> suivant((niveau.size()+1)/2);
+        repartir(suivant.size(), nbTaches, [&](std::size_t i) {
+            suivant[i] = std::move(niveau[2*i]);
+            if (2*i+1 < niveau.size())
+                suivant[i].fusion(std::move(niveau[2*i+1]));
+        });
+        niveau.swap(suivant);
     }
+    return std::move(niveau[0]);
 }
 
 //--------------------------------------------------------------------
@@ -11,12 +11,133 @@
 #include <ostream> // pour le type std::ostream
 #include <set> // pour le type std::set
 #include <vector> // pour le type std::vector
-#include <unordered_map> // pour le type std::unordered_map
+#include <cstdint> // pour le type std::uint32_t
+#include <algorithm> // pour std::min
 #include "individu.hpp" // pour le type Individu
+#include "tableids.hpp" // pour le type TableIds
+#include "segments.hpp" // pour le type Segments
+
+/// Identifiant compact d'un individu dans une forêt (indice de son nœud)
+typedef std::uint32_t PersonId;
+
+/// Vue non possédante sur une suite contiguë d'identifiants, parcourable par une boucle for
+struct VueIds
+{
+    /// Le premier identifiant
+    const PersonId * debut;
+    /// La fin de la suite (après le dernier identifiant)
+    const PersonId * fin;
+    /// Début du parcours
+    const PersonId * begin() const { return debut; }
+    /// Fin du parcours
+    const PersonId * end() const { return fin; }
+    /// Le nombre d'identifiants
+    std::size_t size() const { return (std::size_t)(fin-debut); }
+    /// Vrai ssi la suite est vide
+    bool empty() const { return debut == fin; }
+};
+
+/// Plage non possédante d'identifiants consécutifs, parcourable par une boucle for
+struct PlageIds
+{
+    /// Itérateur sur les identifiants d'une plage
+    struct iterator
+    {
+        /// L'identifiant courant
+        PersonId id;
+        /// L'identifiant courant
+        PersonId operator*() const { return id; }
+        /// Passage à l'identifiant suivant
+        iterator & operator++() { ++id; return *this; }
+        /// Vrai ssi les identifiants diffèrent
+        bool operator!=(const iterator & it) const { return id != it.id; }
+        /// Vrai ssi les identifiants sont égaux
+        bool operator==(const iterator & it) const { return id == it.id; }
+    };
+    /// Le premier identifiant
+    PersonId debut;
+    /// La fin de la plage (après le dernier identifiant)
+    PersonId fin;
+    /// Début du parcours
+    iterator begin() const { return iterator{debut}; }
+    /// Fin du parcours
+    iterator end() const { return iterator{fin}; }
+    /// Le nombre d'identifiants
+    std::size_t size() const { return (std::size_t)(fin-debut); }
+    /// Vrai ssi la plage est vide
+    bool empty() const { return debut == fin; }
+};
+
+/// Vue non possédante sur un individu d'une forêt : le nom est lu dans la table des noms, sans recopie
+struct VueIndividu
+{
+    /// L'identifiant de l'individu
+    PersonId id;
+    /// Son sexe
+    char sexe;
+    /// Le début de son nom, non terminé par '\0'
+    const char * nom;
+    /// La longueur de son nom
+    std::size_t lgNom;
+    /// Sa date de naissance codée (voir Individu::coderDate)
+    std::uint32_t date;
+};
+
+/// Un plus proche ancêtre commun à deux individus et sa distance en générations à chacun d'eux
+struct AncetreCommun
+{
+    /// L'ancêtre commun
+    PersonId ancetre;
+    /// Le nombre de générations qui le séparent du premier individu (0 s'il s'agit de lui)
+    unsigned int d1;
+    /// Le nombre de générations qui le séparent du second individu
+    unsigned int d2;
+};
 
 /**
  * @brief La classe Ancetres représente une forêt généalogique d'ancêtres
 **/
+class Ancetres;
+
+/// Vue non possédante sur les enfants d'un individu, parcourable par une boucle for
+struct VueEnfants
+{
+    /// Itérateur sur les enfants, par identifiant croissant
+    struct iterator
+    {
+        /// La forêt parcourue
+        const Ancetres * anc;
+        /// Le parent dont les enfants sont parcourus
+        PersonId parent;
+        /// L'enfant courant, TableIds::VIDE après le dernier
+        PersonId id;
+        /// L'enfant courant
+        PersonId operator*() const { return id; }
+        /// Passage à l'enfant suivant
+        iterator & operator++();
+        /// Vrai ssi les enfants diffèrent
+        bool operator!=(const iterator & it) const { return id != it.id; }
+        /// Vrai ssi les enfants sont égaux
+        bool operator==(const iterator & it) const { return id == it.id; }
+    };
+    /// La forêt
+    const Ancetres * anc;
+    /// Le parent
+    PersonId parent;
+    /// Son premier enfant, TableIds::VIDE s'il n'en a pas
+    PersonId aine;
+    /// Son nombre d'enfants
+    std::size_t nb;
+    /// Début du parcours
+    iterator begin() const { return iterator{anc, parent, aine}; }
+    /// Fin du parcours
+    iterator end() const { return iterator{anc, parent, TableIds::VIDE}; }
+    /// Le nombre d'enfants
+    std::size_t size() const { return nb; }
+    /// Vrai ssi l'individu n'a pas d'enfant
+    bool empty() const { return nb == 0; }
+};
+
 class Ancetres
 {
     public:
@@ -32,23 +153,77 @@ class Ancetres
         /**
          * @brief Constructeur à partir d'un fichier
          * @param fic Le fichier généalogique
-         * @pre le fichier existe et son format est correct
-         * @post La forêt contient les individus du fichier et leurs liens de filiation
+         * @param nbTaches Le nombre de fils d'exécution pour le déchiffrage (0 = autant que de cœurs)
+         * @pre le fichier existe
+         * @post La forêt contient les individus du fichier et leurs liens de filiation, numérotés comme dans fic
+         * @throw std::out_of_range si une ligne de liens désigne un numéro d'individu absent du fichier
+         * @throw std::invalid_argument si une date de naissance est mal formée ou tronquée (voir Individu::coderDate)
+         * 
+         * le fichier est projeté en mémoire et découpé sur place ; chaque partie est répartie
+         * en morceaux de lignes entières déchiffrés en parallèle, puis les liens sont posés par indice.
+         * Si un individu a plusieurs lignes de liens, la dernière du fichier l'emporte, quel que soit le découpage
          * 
-         * @b Complexité -temporelle :  Θ(N) avec N = nombre d'individus dans fic
+         * @b Complexité -temporelle :  Θ(N/nbTaches + nNoms) avec N = nombre d'individus dans fic
+         *														 nNoms = nombre de noms distincts
          *							 -spatiale : O(N)
          **/
-        Ancetres(std::string fic);
+        Ancetres(std::string fic, unsigned int nbTaches = 0);
+
+        /**
+         * @brief Enregistre la forêt dans un instantané binaire
+         * @param fic Le fichier à écrire
+         * @return Vrai ssi l'instantané a été entièrement écrit
+         * 
+         * l'instantané contient la table des noms, la table des individus, les tableaux des pères
+         * et des mères et les tables de recherche, alignés pour être relus d'un bloc (voir charger)
+         * 
+         * @b Complexité -temporelle : Θ(N) avec N = nombre d'individus dans la forêt
+         *							 -spatiale : O(1)
+         **/
+        bool sauvegarder(const std::string & fic) const;
+
+        /**
+         * @brief Remplace la forêt par celle d'un instantané binaire
+         * @param fic Le fichier écrit par sauvegarder
+         * @return Vrai ssi fic est un instantané valide de la version courante ; sinon la forêt est inchangée
+         * @post La forêt est identique à celle qui a été sauvegardée
+         * 
+         * le fichier est projeté en mémoire et ses tableaux recopiés tels quels : ni déchiffrage, ni hachage.
+         * Tout ce qui sert d'indice est vérifié avant la recopie (parents, indices et positions des noms,
+         * cases des tables de recherche, rangs d'origine) : un instantané abîmé est refusé
+         * 
+         * @b Complexité -temporelle : Θ(N) avec N = nombre d'individus dans l'instantané
+         *							 -spatiale : Θ(N)
+         **/
+        bool charger(const std::string & fic);
 
         /**
          * @brief Affiche dans un flux de sortie (fichier ou écran)
          * @param os Le flux de sortie
          * 
+         * le texte, relisible par le constructeur, est mis en forme dans un tampon (voir TamponSortie)
+         * et écrit par grands blocs, sans vidage du flux ; les individus sont numérotés comme dans le fichier
+         * d'origine, même après renumeroter
+         * 
          * @b Complexité -temporelle : Θ(N) avec N = nombre d'individus dans la forêt
-         *							 -spatiale : O(N)
+         *							 -spatiale : O(1), Θ(N) si la forêt a été renumérotée
          **/
         void afficher(std::ostream & os) const;
 
+        /**
+         * @brief Exporte la forêt en table, une ligne par individu, pour un tableur ou une base de données
+         * @param os Le flux de sortie
+         * @param separateur Le séparateur des champs : '\t' pour TSV, ',' pour CSV
+         * 
+         * une ligne d'en-tête (numero, sexe, nom, date, pere, mere) précède les individus, numérotés à partir
+         * de 1 comme dans le registre (même après renumeroter) ; un parent inconnu laisse son champ vide,
+         * un nom contenant le séparateur ou un guillemet est cité entre guillemets
+         * 
+         * @b Complexité -temporelle : Θ(N) avec N = nombre d'individus dans la forêt
+         *							 -spatiale : O(1), Θ(N) si la forêt a été renumérotée
+         **/
+        void exporter(std::ostream & os, char separateur = '\t') const;
+
         /**
          * @brief Indique si un individu est présent dans la forêt
          * @param ind L'individu à rechercher
@@ -59,16 +234,80 @@ class Ancetres
          **/
         bool estPresent(const Individu & ind) const;
 
+        /**
+         * @brief Indique si un individu, donné par ses parties, est présent dans la forêt
+         * @param sexe Son sexe
+         * @param nom Le début de son nom
+         * @param lgNom La longueur de son nom
+         * @param date Sa date de naissance au format AAAA-MM-JJ (10 caractères, sans '\0' nécessaire)
+         * @return Vrai ssi l'individu est dans la forêt
+         * @throw std::invalid_argument si la date est mal formée (voir Individu::coderDate)
+         * 
+         * la recherche lit le nom et la date sur place, sans construire d'Individu ni allouer
+         * 
+         * @b Complexité -temporelle : Θ(lgNom)
+         *							 -spatiale : O(1)
+         **/
+        bool estPresent(char sexe, const char * nom, std::size_t lgNom, const char * date) const;
+
         /**
          * @brief Ajoute un nouvel individu à la forêt des ancêtres
          * @param ind L'individu à ajouter
          * @pre L'individu n'est pas déjà dans la forêt
+         * @return L'identifiant attribué à l'individu
          * @post L'individu inséré n'a ni père ni mère
+         * @throw std::length_error si son nom dépasse NOM_MAX caractères
+         * 
+         * @b Complexité -temporelle : Θ(1)
+         *							 -spatiale : O(1)
+         **/
+        PersonId ajouter(const Individu & ind);
+
+        /**
+         * @brief Donne le nombre d'individus de la forêt
+         * @return Le nombre d'individus, qui borne les identifiants valides
+         * 
+         * @b Complexité -temporelle : Θ(1)
+         *							 -spatiale : O(1)
+         **/
+        std::size_t taille() const;
+
+        /**
+         * @brief Accède à l'identifiant d'un individu
+         * @param ind L'individu considéré
+         * @return L'identifiant de ind dans la forêt
+         * @pre L'individu est dans la forêt
          * 
          * @b Complexité -temporelle : Θ(1)
          *							 -spatiale : O(1)
          **/
-        void ajouter(const Individu & ind);
+        PersonId identifiant(const Individu & ind) const;
+
+        /**
+         * @brief Accède à l'identifiant d'un individu donné par ses parties, sans construire d'Individu
+         * @param sexe Son sexe
+         * @param nom Le début de son nom
+         * @param lgNom La longueur de son nom
+         * @param date Sa date de naissance au format AAAA-MM-JJ (10 caractères, sans '\0' nécessaire)
+         * @return L'identifiant de l'individu dans la forêt
+         * @pre L'individu est dans la forêt
+         * @throw std::invalid_argument si la date est mal formée (voir Individu::coderDate)
+         * 
+         * @b Complexité -temporelle : Θ(lgNom)
+         *							 -spatiale : O(1)
+         **/
+        PersonId identifiant(char sexe, const char * nom, std::size_t lgNom, const char * date) const;
+
+        /**
+         * @brief Reconstruit l'individu désigné par un identifiant
+         * @param id L'identifiant considéré
+         * @return L'individu d'identifiant id
+         * @pre id < taille()
+         * 
+         * @b Complexité -temporelle : Θ(1)
+         *							 -spatiale : O(1)
+         **/
+        Individu individu(PersonId id) const;
         
         /**
          * @brief Indique si le père d'un individu est connu
@@ -79,7 +318,9 @@ class Ancetres
          * @b Complexité -temporelle : Θ(1)
          *							 -spatiale : O(1)
          **/
-        bool hasPere(Individu ind) const;
+        bool hasPere(const Individu & ind) const;
+        /// @overload
+        bool hasPere(PersonId id) const;
         
         /**
          * @brief Accède au père d'un individu
@@ -90,7 +331,9 @@ class Ancetres
          * @b Complexité -temporelle : Θ(1)
          *							 -spatiale : O(1)
          **/
-        Individu getPere(Individu ind) const;
+        Individu getPere(const Individu & ind) const;
+        /// @overload
+        PersonId getPere(PersonId id) const;
         
         /**
          * @brief Modifie le père d'un individu
@@ -99,10 +342,14 @@ class Ancetres
          * @pre L'individu et son père sont déjà dans la forêt
          * @post L'individu a changé de père
          * 
-         * @b Complexité -temporelle : Θ(1)
-         *							 -spatiale : O(1)
+         * l'enfant change de fratrie (voir enfants), et les générations à jour le restent (voir generation)
+         * 
+         * @b Complexité -temporelle : Θ(nombre d'enfants des parents concernés), plus O(N/16) pour les générations
+         *							 -spatiale : O(N/16)
          **/
-        void setPere(Individu ind, Individu pere);
+        void setPere(const Individu & ind, const Individu & pere);
+        /// @overload
+        void setPere(PersonId id, PersonId pere);
         
         /**
          * @brief Indique si la mère d'un individu est connue
@@ -113,7 +360,9 @@ class Ancetres
          * @b Complexité -temporelle : Θ(1)
          *							 -spatiale : O(1)
          **/
-        bool hasMere(Individu ind) const;
+        bool hasMere(const Individu & ind) const;
+        /// @overload
+        bool hasMere(PersonId id) const;
         
         /**
          * @brief Accède à la mère d'un individu
@@ -124,7 +373,9 @@ class Ancetres
          * @b Complexité -temporelle : Θ(1)
          *							 -spatiale : O(1)
          **/
-        Individu getMere(Individu ind) const;
+        Individu getMere(const Individu & ind) const;
+        /// @overload
+        PersonId getMere(PersonId id) const;
         
         /**
          * @brief Modifie la mère d'un individu
@@ -133,19 +384,62 @@ class Ancetres
          * @pre L'individu et sa mère sont déjà dans la forêt
          * @post L'individu a changé de mère
          * 
-         * @b Complexité -temporelle : Θ(1)
-         *							 -spatiale : O(1)
+         * comme setPere
+         * 
+         * @b Complexité -temporelle : Θ(nombre d'enfants des parents concernés), plus O(N/16) pour les générations
+         *							 -spatiale : O(N/16)
          **/
-        void setMere(Individu ind, Individu mere);
+        void setMere(const Individu & ind, const Individu & mere);
+        /// @overload
+        void setMere(PersonId id, PersonId mere);
 
         /**
          * @brief Calcule l'ensemble des individus sans enfants dans la forêt
          * @return Les individus racines de la forêt
          * 
-         * @b Complexité -temporelle : O(N) avec N = nombre d'individus dans la forêt
-         *							 -spatiale : O(nRes + N)
+         * @b Complexité -temporelle : O(nRes*log(nRes))
+         *							 -spatiale : O(nRes)
          **/
         std::set<Individu> racines() const;
+
+        /**
+         * @brief Accède aux identifiants des individus racines de la forêt, sans enfant connu
+         * @return Les identifiants des racines, dans un ordre quelconque ;
+         *         le tableau reste valide jusqu'à la prochaine modification de la forêt
+         * 
+         * l'ensemble des racines est tenu à jour à chaque ajout et à chaque modification d'un lien
+         * 
+         * @b Complexité Θ(1)
+         **/
+        const Segments<PersonId> & idsRacines() const;
+
+        /**
+         * @brief Donne le nombre de racines de la forêt
+         * @return Le nombre d'individus sans enfant connu
+         * 
+         * @b Complexité Θ(1)
+         **/
+        std::size_t nbRacines() const;
+
+        /**
+         * @brief Donne le nombre d'enfants d'un individu
+         * @param id L'individu considéré
+         * @pre id < taille()
+         * @return Le nombre d'individus dont id est le père ou la mère
+         * 
+         * @b Complexité Θ(1)
+         **/
+        std::size_t nombreEnfants(PersonId id) const;
+
+        /**
+         * @brief Applique un visiteur à chaque racine de la forêt, sans allocation
+         * @param v Le visiteur, appelé avec la VueIndividu de chaque racine, dans l'ordre de idsRacines
+         * 
+         * @b Complexité -temporelle : Θ(nRes) appels de v
+         *							 -spatiale : O(1)
+         **/
+        template<class Visiteur>
+        void pourChaqueRacine(Visiteur v) const;
         
         /**
          * @brief Accède à l'ensemble des individus dans la forêt
@@ -155,44 +449,679 @@ class Ancetres
          *							 -spatiale : O(N)
          **/
         std::set<Individu> individus() const;
+
+        /**
+         * @brief Donne la plage des identifiants de la forêt
+         * @return Les identifiants de 0 à taille()-1
+         * 
+         * @b Complexité Θ(1)
+         **/
+        PlageIds idsIndividus() const;
+
+        /**
+         * @brief Accède à un individu sans le recopier
+         * @param id L'identifiant de l'individu
+         * @pre id < taille()
+         * @return La vue de l'individu, valide jusqu'à la prochaine modification de la forêt
+         * 
+         * @b Complexité Θ(1)
+         **/
+        VueIndividu vue(PersonId id) const;
+
+        /**
+         * @brief Applique un visiteur à chaque individu de la forêt, sans allocation
+         * @param v Le visiteur, appelé avec la VueIndividu de chaque individu, par identifiant croissant
+         * 
+         * les nœuds sont parcourus dans l'ordre du tableau, d'un seul balayage
+         * 
+         * @b Complexité -temporelle : Θ(N) appels de v
+         *							 -spatiale : O(1)
+         **/
+        template<class Visiteur>
+        void pourChaqueIndividu(Visiteur v) const;
         
         /**
          * @brief Calcule l'ensemble des ancêtres communs à deux individus
          * @pre Les individus sont bien dans la forêt
          * @return La forêt des ancêtres communs
          * 
-         * @b Complexité -temporelle : O(N*N) avec N = nombre d'individus dans la forêt
-         *							 -spatiale : O(nAncInd1+ nAncInd2 + 1)
-         *													 avec nAncInd1 le nombre d'ancêtres de l'individu 1
-         *													 nAncInd2 le nombre d'ancêtres de l'individu 2
+         * chaque ancêtre n'est visité qu'une fois, même s'il apparaît par plusieurs lignées,
+         * grâce à un marquage par époque des nœuds
+         * 
+         * @b Complexité -temporelle : O(nAncInd1 + nAncInd2) hors première requête du fil, qui alloue les marques en Θ(N)
+         *													 avec nAncInd1 le nombre d'ancêtres distincts de l'individu 1
+         *													 nAncInd2 le nombre d'ancêtres distincts de l'individu 2
+         *							 -spatiale : O(N) avec N = nombre d'individus dans la forêt
+         **/
+        Ancetres ancetresCommuns(const Individu & ind1, const Individu & ind2) const;
+        /// @overload
+        Ancetres ancetresCommuns(PersonId id1, PersonId id2) const;
+
+        /**
+         * @brief Calcule les ancêtres communs de chaque paire d'individus d'un lot
+         * @param paires Les paires d'identifiants à traiter
+         * @pre Les individus sont bien dans la forêt
+         * @return La forêt des ancêtres communs de chaque paire, dans l'ordre de paires
+         * 
+         * les marques et files de parcours sont allouées une seule fois pour tout le lot
+         * 
+         * @b Complexité -temporelle : Θ(N) + somme des O(nAncInd1 + nAncInd2) de chaque paire
+         *							 -spatiale : O(N + taille du résultat)
+         **/
+        std::vector<Ancetres> ancetresCommuns(const std::vector<std::pair<PersonId,PersonId>> & paires) const;
+
+        /**
+         * @brief Calcule les plus proches ancêtres communs à deux individus
+         * @param id1 Le premier individu
+         * @param id2 Le second individu
+         * @pre Les individus sont bien dans la forêt
+         * @return Les ancêtres communs dont aucun descendant n'est commun, avec la plus courte distance
+         *         en générations à chaque individu, par distance totale croissante
+         * 
+         * un individu ancêtre de l'autre est son propre plus proche ancêtre commun, à distance 0 ;
+         * la recherche remonte des deux individus à la fois, génération par génération, et ne dépasse pas
+         * un nœud atteint des deux côtés ; les candidats sont ensuite filtrés grâce aux générations des nœuds
+         * 
+         * @b Complexité -temporelle : O(nAncInd1 + nAncInd2) hors première requête du fil, plus O(N) pour recalculer
+         *													 les générations après une modification des liens
+         *							 -spatiale : O(N)
+         **/
+        std::vector<AncetreCommun> plusProchesAncetresCommuns(PersonId id1, PersonId id2) const;
+        /// @overload
+        std::vector<AncetreCommun> plusProchesAncetresCommuns(const Individu & ind1, const Individu & ind2) const;
+
+        /**
+         * @brief Calcule l'ensemble des ancêtres d'un individu, jusqu'à une génération donnée
+         * @param id L'individu
+         * @param maxGen Le nombre de générations remontées (0 : l'individu seul)
+         * @pre L'individu est bien dans la forêt
+         * @return La forêt formée de l'individu et de ses ancêtres à au plus maxGen générations de lui,
+         *         avec les liens de filiation qui les unissent
+         * 
+         * remontée en largeur, génération par génération : un ancêtre atteint par plusieurs lignées (implexe)
+         * n'est visité qu'une fois, à sa plus courte distance
+         * 
+         * @b Complexité -temporelle : O(nAnc) hors première requête du fil, avec nAnc le nombre d'ancêtres distincts retenus
+         *							 -spatiale : O(N) avec N = nombre d'individus dans la forêt
+         **/
+        Ancetres ancetres(PersonId id, unsigned int maxGen = 0xFFFFFFFFu) const;
+        /// @overload
+        Ancetres ancetres(const Individu & ind, unsigned int maxGen = 0xFFFFFFFFu) const;
+
+        /**
+         * @brief Applique un visiteur à chaque ancêtre d'un individu, numéroté selon Sosa-Stradonitz
+         * @param id L'individu, de numéro 1
+         * @param maxGen Le nombre de générations remontées, 63 au plus
+         * @param v Le visiteur, appelé avec (numéro, identifiant de l'ancêtre, plus petit numéro de cet ancêtre),
+         *          par numéro croissant ; il ne doit pas lancer d'autre requête d'ancêtres dans le même fil
+         * @pre L'individu est bien dans la forêt
+         * 
+         * le père de l'individu numéro n porte le numéro 2n, sa mère 2n+1 ; un ancêtre atteint par plusieurs
+         * lignées (implexe) reçoit chacun de ses numéros. Chaque génération est produite par un parcours
+         * en profondeur limité, dont la pile, de taille O(maxGen), est celle du fil : la mémoire ne croît pas
+         * avec le nombre de numéros, qui peut doubler à chaque génération d'une lignée à fort implexe
+         * 
+         * @b Complexité -temporelle : O(nombre de numéros) pour un arbre bien rempli, O(maxGen * nombre de numéros) au pire
+         *							 -spatiale : O(maxGen), plus Θ(N) à la première requête du fil
+         **/
+        template<class Visiteur>
+        void pourChaqueSosa(PersonId id, unsigned int maxGen, Visiteur v) const;
+
+        /**
+         * @brief Écrit la liste de Sosa (ahnentafel) des ancêtres d'un individu
+         * @param os Le flux de sortie
+         * @param id L'individu, de numéro 1
+         * @param maxGen Le nombre de générations remontées, 63 au plus
+         * @pre L'individu est bien dans la forêt
+         * 
+         * une ligne "numéro   S   NOM   DATE" par numéro, dans l'ordre croissant (voir pourChaqueSosa) ;
+         * les numéros suivants d'un implexe sont complétés par "= plus petit numéro". Le texte est écrit
+         * au fil du parcours, par un tampon (voir TamponSortie)
+         * 
+         * @b Complexité celle de pourChaqueSosa
+         **/
+        void afficherSosa(std::ostream & os, PersonId id, unsigned int maxGen) const;
+        /// @overload
+        void afficherSosa(std::ostream & os, const Individu & ind, unsigned int maxGen) const;
+
+        /**
+         * @brief Donne la génération d'un individu, longueur de sa plus longue lignée d'ancêtres connus
+         * @param id L'individu considéré
+         * @pre id < taille()
+         * @return 0 si l'individu n'a aucun parent connu, 1 + la plus grande génération de ses parents sinon
+         * 
+         * une fois calculées, les générations sont tenues à jour par setPere et setMere, qui propagent un changement
+         * aux descendants ; une propagation trop longue (plus de N/16 descendants, ou un cycle) les fait recalculer
+         * ensemble à la demande suivante, comme un chargement ou une fusion, et une forêt qui a un cycle les recalcule
+         * après chaque modification de lien
+         * 
+         * @b Complexité -temporelle : Θ(1), ou Θ(N) s'il faut recalculer les générations
+         *							 -spatiale : O(N)
+         **/
+        unsigned int generation(PersonId id) const;
+
+        /**
+         * @brief Accède aux enfants d'un individu
+         * @param id L'individu considéré
+         * @pre id < taille()
+         * @return Les identifiants des individus dont id est le père ou la mère, par identifiant croissant ;
+         *         la vue reste valide jusqu'à la prochaine modification de la forêt
+         * 
+         * les enfants d'un individu forment une fratrie chaînée : il désigne son aîné, chaque enfant son cadet
+         * du côté de son père et du côté de sa mère. Les fratries sont tenues à jour par setPere et setMere,
+         * sans rien reconstruire, ce qui laisse une copie de la forêt partager tout le reste (voir Segments)
+         * 
+         * @b Complexité -temporelle : Θ(1), puis Θ(1) par enfant parcouru
+         *							 -spatiale : O(1)
+         **/
+        VueEnfants enfants(PersonId id) const;
+
+        /**
+         * @brief Donne le numéro de l'espace d'identifiants de la forêt
+         * @return Un numéro non nul propre à la forêt ; deux forêts distinctes, copies comprises, n'ont jamais
+         *         le même, et il change lorsque charger remplace les identifiants
+         * 
+         * deux ensembles d'identifiants ne se comparent que s'ils viennent du même espace (voir Descendants::identifiants)
+         * 
+         * @b Complexité Θ(1)
+         **/
+        std::uint64_t espace() const;
+
+        /**
+         * @brief Calcule d'avance tout ce que les méthodes const calculent à la demande (générations)
+         * @post Jusqu'à la prochaine modification, les méthodes const ne modifient plus rien et peuvent être
+         *       appelées de plusieurs fils à la fois (voir ForetPartagee)
+         * 
+         * @b Complexité -temporelle : Θ(N) si les générations sont à recalculer, Θ(1) sinon
+         *							 -spatiale : O(N)
+         **/
+        void figer() const;
+
+        /**
+         * @brief Renumérote les individus pour que les parcours vers les ancêtres restent proches en mémoire
+         * @return Vrai ssi la forêt est sans cycle (aucun individu n'est son propre ancêtre)
+         * @post Les individus, leurs liens et l'affichage sont inchangés ; les identifiants changent
+         *       (un nouvel espace est tiré, voir espace) et numeroOrigine donne le rang de chacun dans le fichier
+         * 
+         * les individus sont rangés en ordre topologique des enfants vers les parents, génération par génération :
+         * un individu suit tous ses enfants, et le père et la mère d'un même enfant se suivent le plus souvent.
+         * Les individus d'un cycle, et leurs ancêtres, n'ont pas de place dans cet ordre : ils sont rangés
+         * à la fin, dans l'ordre actuel, ce qui révèle le cycle
+         * 
+         * @b Complexité -temporelle : Θ(N) avec N = nombre d'individus dans la forêt
+         *							 -spatiale : Θ(N)
+         **/
+        bool renumeroter();
+
+        /**
+         * @brief Donne le rang d'origine d'un individu, celui de sa ligne dans le fichier de la forêt
+         * @param id L'identifiant de l'individu
+         * @pre id < taille()
+         * @return Son rang à partir de 0, égal à id tant que la forêt n'a pas été renumérotée (voir renumeroter)
+         * 
+         * @b Complexité Θ(1)
+         **/
+        PersonId numeroOrigine(PersonId id) const;
+
+        /**
+         * @brief Donne l'identifiant de l'individu d'un rang d'origine, l'inverse de numeroOrigine
+         * @param rang Le rang de l'individu dans le fichier de la forêt, à partir de 0
+         * @pre rang < taille()
+         * @return Son identifiant, égal à rang tant que la forêt n'a pas été renumérotée (voir renumeroter)
+         * 
+         * @b Complexité Θ(1)
          **/
-        Ancetres ancetresCommuns(Individu ind1, Individu ind2) const;
+        PersonId identifiantOrigine(PersonId rang) const;
 
         /**
          * @brief Fusionne l'instance avec la forêt passée en paramètre
          * @param anc La forêt à fusionner
+         * @post Les individus de anc absents de l'instance y sont ajoutés, dans l'ordre de anc (celui de son fichier,
+         *       même si anc a été renumérotée : voir identifiantOrigine) ;
+         *       un individu sans père (ou sans mère) connu reçoit celui que lui donne anc
+         * 
+         * une table de correspondance des identifiants de anc vers ceux de l'instance est construite en un passage,
+         * chaque nom de anc n'étant interné qu'une fois ; les parents sont ensuite posés par indice, sans recherche
+         * 
+         * @b Complexité -temporelle : Θ(M) en moyenne, avec M = nombre d'individus dans la forêt passée en paramètre
+         *							 -spatiale : Θ(M)
+         **/
+        void fusion(const Ancetres & anc);
+
+        /**
+         * @brief Fusionne l'instance avec une forêt dont on n'a plus besoin
+         * @param anc La forêt à fusionner, vidée par l'opération
+         * @post Comme pour fusion(const Ancetres &)
+         * 
+         * si l'instance est vide, elle reprend simplement les tableaux de anc, sans recopie
+         * 
+         * @b Complexité -temporelle : Θ(1) si l'instance est vide, Θ(M) en moyenne sinon
+         *							 -spatiale : Θ(M)
+         **/
+        void fusion(Ancetres && anc);
+
+        /**
+         * @brief Réunit plusieurs forêts en une seule
+         * @param forets Les forêts à réunir
+         * @param nbTaches Le nombre de fils d'exécution à employer, 0 pour autant que de cœurs
+         * @return La forêt obtenue en fusionnant les forêts dans l'ordre dans une forêt vide
          * 
-         * @b Complexité -temporelle : O(N+M) avec N = nombre d'individus dans la forêt
-         *													   M = nombre d'invidus dans la forêt passée en paramètre
-         *							 -spatiale : O(anc + N)
-         *													 avec anc la taille de l'Ancetres passé en paramètre
-         *													 N = nombre d'individus dans la forêt
+         * la fusion étant associative (le premier parent connu l'emporte, les nouveaux individus suivent l'ordre des forêts),
+         * les forêts sont réunies deux à deux, chaque niveau en parallèle, jusqu'à n'en plus former qu'une ;
+         * avec un seul fil, elles sont simplement fusionnées l'une après l'autre
+         * 
+         * @b Complexité -temporelle : Θ(M) en moyenne avec un seul fil, Θ(M*log(k)) réparti sur les fils sinon,
+         *													   avec M le nombre total d'individus et k le nombre de forêts
+         *							 -spatiale : Θ(M)
          **/
-        void fusion(Ancetres anc);
+        static Ancetres fusionner(const std::vector<const Ancetres*> & forets, unsigned int nbTaches = 0);
+
+        /// Longueur maximale d'un nom : les caractères d'un nom tiennent dans un seul segment (voir nomsCar)
+        static const std::size_t NOM_MAX = Segments<char,14>::TAILLE;
         
     private:
+        // l'ingestion concurrente assemble ses nœuds directement, comme le chargement d'un fichier
+        friend class Ingestion;
+        // la construction d'un arbre de descendants marque les individus atteints avec le marquage du fil
+        friend class Descendants;
+        // le parcours d'une fratrie suit le chaînage des enfants
+        friend struct VueEnfants;
         // Un nœud de la forêt contient un individu et les indices de ses parents (-1 si inconnus)
+        // le nom est interné : le nœud ne garde que son indice dans la table des noms
         struct Noeud {
-            Individu ind; // l'individu représenté
+            char sexe; // le sexe de l'individu représenté
+            std::uint32_t nom; // l'indice de son nom dans la table des noms
+            std::uint32_t date; // sa date de naissance codée (voir Individu::coderDate)
             int pere, mere; // son père, sa mère
         };
+        // La place d'un nom interné dans nomsCar
+        struct Nom {
+            std::uint32_t debut; // position de son premier caractère
+            std::uint32_t lg; // nombre de caractères
+        };
+        // Le chaînage des enfants d'un nœud et de ses frères et sœurs, par identifiant croissant (TableIds::VIDE en fin de fratrie)
+        // un enfant dont le père est aussi la mère n'est chaîné que du côté de son père
+        struct Fratrie {
+            PersonId aine; // le premier enfant du nœud
+            PersonId cadetPere; // l'enfant suivant du père du nœud
+            PersonId cadetMere; // l'enfant suivant de la mère du nœud
+        };
+        // Une ligne de liens d'un fichier : l'individu, son père, sa mère (-1 si inconnus)
+        struct Lien {
+            PersonId id;
+            int pere, mere;
+        };
+        // Mémoire de travail des parcours d'ancêtres, réutilisée d'une requête à l'autre
+        // un nœud est visité pendant la requête courante ssi sa marque vaut l'une des époques de la requête
+        struct Marquage {
+            std::vector<std::uint32_t> marque; // époque de la dernière visite de chaque nœud
+            std::uint32_t epoque; // dernière époque attribuée
+            std::vector<PersonId> rang; // identifiant dans le résultat de chaque ancêtre commun
+            std::vector<PersonId> file1, file2; // files des parcours depuis chacun des individus
+            std::vector<std::uint32_t> marqueBis; // marques d'un parcours secondaire, par époque aussi
+            std::vector<std::uint32_t> dist1, dist2; // distance en générations à chacun des individus
+            std::vector<std::uint64_t> sosa; // plus petit numéro de Sosa de chaque ancêtre, alloué à la première liste de Sosa
+            struct Position { PersonId id; std::uint32_t gen; std::uint64_t numero; };
+            std::vector<Position> pileSosa; // pile du parcours de Sosa
+        };
+        // Numéro d'espace d'identifiants, tiré à nouveau à chaque construction, copie ou affectation
+        struct Espace {
+            std::uint64_t numero;
+            Espace();
+            Espace(const Espace &);
+            Espace & operator=(const Espace &);
+        };
         // Attributs
-        std::vector<Noeud> noeuds; // Le tableau des nœuds
-        std::unordered_map<Individu,unsigned int> indTOnd; // table associative Individu->Nœud
+        // tous les tableaux sont segmentés : une copie de la forêt partage leurs segments jusqu'à ce qu'elle les modifie
+        Segments<Noeud> noeuds; // Le tableau des nœuds
+        TableIds indTOnd; // table associative Individu->Nœud, hachée sur (indice du nom, clé de l'individu)
+        Segments<char,14> nomsCar; // Les caractères des noms internés, mis bout à bout ; un nom ne chevauche jamais deux segments
+        Segments<Nom> noms; // place de chaque nom dans nomsCar
+        TableIds nomTOid; // table associative nom->indice dans noms
+        mutable Segments<std::uint32_t> generations; // génération de chaque nœud (voir generation)
+        mutable bool generationsAJour; // faux si les générations sont à recalculer
+        mutable bool generationsCycle; // vrai si leur dernier calcul a ignoré le lien d'un cycle
+        Segments<Fratrie> fratries; // chaînage des enfants de chaque nœud (voir enfants)
+        Segments<std::uint32_t> nbEnfants; // nombre d'enfants de chaque nœud
+        Segments<PersonId> racinesIds; // les nœuds sans enfant, dans un ordre quelconque
+        Segments<std::uint32_t> rangRacine; // position de chaque nœud dans racinesIds, TableIds::VIDE s'il a un enfant
+        Espace numeroEspace; // l'espace des identifiants de noeuds (voir espace)
+        Segments<PersonId> origine; // rang d'origine de chaque nœud, vide tant que la forêt n'a pas été renumérotée
+        Segments<PersonId> idsOrigine; // nœud de chaque rang d'origine, l'inverse de origine, vide avec elle
         // Méthodes
-        // EN AJOUTER AU BESOIN
+
+        /**
+         * @brief Interne un nom dans la table des noms
+         * @param nom Le début du nom
+         * @param lg La longueur du nom
+         * @return L'indice du nom dans la table, ajouté s'il n'y était pas
+         * @throw std::length_error si lg dépasse NOM_MAX
+         * 
+         * @b Complexité -temporelle : Θ(lg)
+         *							 -spatiale : O(lg)
+         **/
+        std::uint32_t interner(const char * nom, std::size_t lg);
+
+        /**
+         * @brief Range les caractères d'un nouveau nom à la fin de nomsCar
+         * @param nom Le début du nom
+         * @param lg La longueur du nom
+         * @pre lg <= NOM_MAX
+         * @return La place du nom ; un nom qui déborderait du dernier segment commence au suivant
+         * 
+         * @b Complexité -temporelle : Θ(lg) amortie
+         *							 -spatiale : O(NOM_MAX)
+         **/
+        Nom rangerNom(const char * nom, std::size_t lg);
+
+        /**
+         * @brief Accède aux caractères d'un nom interné
+         * @param nom L'indice du nom
+         * @return Ses noms[nom].lg caractères, contigus
+         * 
+         * @b Complexité Θ(1)
+         **/
+        const char * caracteres(std::uint32_t nom) const;
+
+        /**
+         * @brief Recherche un nom dans la table des noms
+         * @param nom Le début du nom
+         * @param lg La longueur du nom
+         * @return L'indice du nom dans la table, TableIds::VIDE s'il n'y est pas
+         * 
+         * @b Complexité -temporelle : Θ(lg)
+         *							 -spatiale : O(1)
+         **/
+        std::uint32_t trouverNom(const char * nom, std::size_t lg) const;
+
+        /**
+         * @brief Recherche un individu par son nom interné et sa clé
+         * @param nom L'indice du nom
+         * @param cle La clé de l'individu (voir Individu::cle)
+         * @return L'identifiant de l'individu, TableIds::VIDE s'il n'est pas dans la forêt
+         * 
+         * @b Complexité -temporelle : Θ(1)
+         *							 -spatiale : O(1)
+         **/
+        PersonId trouver(std::uint32_t nom, std::uint32_t cle) const;
+
+        /**
+         * @brief Recherche un individu par ses parties
+         * @param sexe Son sexe
+         * @param nom Le début de son nom
+         * @param lg La longueur de son nom
+         * @param date Sa date de naissance codée
+         * @return L'identifiant de l'individu, TableIds::VIDE s'il n'est pas dans la forêt
+         * 
+         * @b Complexité -temporelle : Θ(lg)
+         *							 -spatiale : O(1)
+         **/
+        PersonId trouver(char sexe, const char * nom, std::size_t lg, std::uint32_t date) const;
+
+        /**
+         * @brief Recherche un individu
+         * @param ind L'individu à rechercher
+         * @return L'identifiant de l'individu, TableIds::VIDE s'il n'est pas dans la forêt
+         * 
+         * @b Complexité -temporelle : Θ(1)
+         *							 -spatiale : O(1)
+         **/
+        PersonId trouver(const Individu & ind) const;
+
+        /**
+         * @brief Range un nœud déjà ajouté dans la table des individus
+         * @param id L'identifiant du nœud
+         * 
+         * @b Complexité -temporelle : Θ(1) amortie
+         *							 -spatiale : O(1) amortie
+         **/
+        void indexer(PersonId id);
+
+        /**
+         * @brief Hache un individu par son nom interné et sa clé
+         * @param nom L'indice du nom
+         * @param cle La clé de l'individu (voir Individu::cle)
+         * @return Le hachage utilisé dans indTOnd
+         * 
+         * @b Complexité Θ(1)
+         **/
+        static std::uint64_t hacher(std::uint32_t nom, std::uint32_t cle);
+
+        /**
+         * @brief Calcule les ancêtres communs à deux individus avec une mémoire de travail donnée
+         * @param id1 Le premier individu
+         * @param id2 Le second individu
+         * @param m La mémoire de travail, éventuellement déjà utilisée pour cette forêt
+         * @return La forêt des ancêtres communs
+         * 
+         * @b Complexité -temporelle : O(nAncInd1 + nAncInd2), plus Θ(N) si m n'a pas encore servi
+         *							 -spatiale : O(N)
+         **/
+        Ancetres ancetresCommuns(PersonId id1, PersonId id2, Marquage & m) const;
+
+        /**
+         * @brief Construit la forêt des nœuds parcourus qui portent une marque donnée
+         * @param parcours Les nœuds parcourus, ajoutés au résultat du dernier au premier s'ils sont retenus
+         * @param m La mémoire de travail du parcours
+         * @param vu La marque des nœuds retenus
+         * @return La forêt des nœuds retenus, avec les liens qui les unissent
+         * 
+         * @b Complexité -temporelle : O(parcours.size())
+         *							 -spatiale : O(nombre de nœuds retenus)
+         **/
+        Ancetres extraire(const std::vector<PersonId> & parcours, Marquage & m, std::uint32_t vu) const;
+
+        /**
+         * @brief Prépare une mémoire de travail pour une nouvelle requête
+         * @param m La mémoire de travail
+         * @param nbEpoques Le nombre d'époques consommées par la requête
+         * @return La première des époques de la requête
+         * 
+         * @b Complexité -temporelle : Θ(1), ou Θ(N) à la première requête et quand les époques s'épuisent
+         *							 -spatiale : O(N)
+         **/
+        std::uint32_t preparer(Marquage & m, std::uint32_t nbEpoques) const;
+
+        /**
+         * @brief Donne la mémoire de travail propre au fil appelant
+         * @return Un marquage réutilisé par toutes les requêtes du fil, sur n'importe quelle forêt
+         * 
+         * les époques ne faisant que croître, une marque laissée par une autre requête, même sur une autre forêt,
+         * n'est jamais prise pour une visite de la requête courante ; le marquage garde la taille de la plus
+         * grande forêt interrogée par le fil
+         * 
+         * @b Complexité Θ(1)
+         **/
+        static Marquage & marquageDuFil();
+
+        /**
+         * @brief Recalcule la génération de chaque nœud si les liens ont changé
+         * 
+         * @b Complexité -temporelle : Θ(N) si generations n'est pas à jour, Θ(1) sinon
+         *							 -spatiale : O(N)
+         **/
+        void calculerGenerations() const;
+
+        /**
+         * @brief Met à jour la génération d'un nœud dont un parent a changé, puis celle de ses descendants
+         * @param id Le nœud
+         * 
+         * au-delà de N/16 nœuds mis à jour, ce qui arrête aussi une propagation autour d'un cycle,
+         * ou si le dernier calcul complet a ignoré un lien, les générations sont déclarées à recalculer
+         * 
+         * @b Complexité -temporelle : O(N/16), Θ(1) si les générations sont déjà à recalculer
+         *							 -spatiale : O(N/16)
+         **/
+        void propagerGeneration(PersonId id);
+
+        /**
+         * @brief Donne l'enfant qui suit un autre dans la fratrie d'un parent
+         * @param enf L'enfant
+         * @param par Son père ou sa mère
+         * @return Le cadet de enf du côté de par, TableIds::VIDE si enf est le dernier
+         * 
+         * @b Complexité Θ(1)
+         **/
+        PersonId cadet(PersonId enf, PersonId par) const;
+
+        /**
+         * @brief Accède en écriture au lien d'un enfant vers son cadet dans la fratrie d'un parent
+         * @param enf L'enfant
+         * @param par Son père ou sa mère
+         * @return Le lien, cadetPere si par est le père de enf, cadetMere sinon
+         * 
+         * @b Complexité Θ(1)
+         **/
+        PersonId & lienCadet(PersonId enf, PersonId par);
+
+        /**
+         * @brief Insère un enfant dans la fratrie d'un parent, à son rang d'identifiant
+         * @param par Le parent
+         * @param enf L'enfant, dont le lien vers par est déjà posé
+         * 
+         * seuls le segment de l'enfant et celui de son prédécesseur sont écrits
+         * 
+         * @b Complexité Θ(nombre d'enfants de par)
+         **/
+        void lierEnfant(PersonId par, PersonId enf);
+
+        /**
+         * @brief Retire un enfant de la fratrie d'un parent
+         * @param par Le parent
+         * @param enf L'enfant, dont le lien vers par est encore posé
+         * 
+         * @b Complexité Θ(nombre d'enfants de par)
+         **/
+        void delierEnfant(PersonId par, PersonId enf);
+
+        /**
+         * @brief Ajoute un nœud sans parents, son nom étant déjà interné
+         * @param sexe Le sexe de l'individu
+         * @param nom L'indice de son nom
+         * @param date Sa date de naissance codée
+         * @pre L'individu n'est pas dans la forêt
+         * @return L'identifiant du nouveau nœud
+         * 
+         * les index et les caches à jour sont prolongés sur place
+         * 
+         * @b Complexité -temporelle : Θ(1) en moyenne amortie
+         *							 -spatiale : O(1) amortie
+         **/
+        PersonId ajouterNoeud(char sexe, std::uint32_t nom, std::uint32_t date);
+
+        /**
+         * @brief Recompte les enfants de chaque nœud, rechaîne les fratries et reconstruit l'ensemble des racines
+         * 
+         * nécessaire après un chargement ou des liens posés sans passer par setPere et setMere
+         * 
+         * @b Complexité -temporelle : Θ(N)
+         *							 -spatiale : Θ(N)
+         **/
+        void recompterEnfants();
+
+        /**
+         * @brief Compte un enfant de plus pour un parent, qui cesse d'être une racine s'il l'était
+         * @param par Le parent
+         * 
+         * @b Complexité Θ(1)
+         **/
+        void gagnerEnfant(PersonId par);
+
+        /**
+         * @brief Compte un enfant de moins pour un parent, qui redevient une racine s'il n'en a plus
+         * @param par Le parent
+         * 
+         * @b Complexité Θ(1)
+         **/
+        void perdreEnfant(PersonId par);
+
+        /**
+         * @brief Déchiffre un morceau de la partie individus d'un fichier
+         * @param deb Le début du morceau, en début de ligne
+         * @param fin La fin du morceau, en début de ligne ou en fin de fichier
+         * @param nds Les nœuds lus, dont le nom est un indice dans nomsLus
+         * @param nomsLus Les noms distincts du morceau, par ordre d'apparition
+         * 
+         * @b Complexité -temporelle : Θ(fin-deb)
+         *							 -spatiale : O(fin-deb)
+         **/
+        static void lireIndividus(const char * deb, const char * fin,
+                                  std::vector<Noeud> & nds, std::vector<std::string> & nomsLus);
+
+        /**
+         * @brief Déchiffre un morceau de la partie liens d'un fichier
+         * @param deb Le début du morceau, en début de ligne
+         * @param fin La fin du morceau, en début de ligne ou en fin de fichier
+         * @param nbNoeuds Le nombre d'individus du fichier
+         * @param liens Les liens lus, dans l'ordre du morceau
+         * @throw std::out_of_range si une ligne désigne un numéro supérieur à nbNoeuds
+         * 
+         * @b Complexité -temporelle : Θ(fin-deb)
+         *							 -spatiale : O(fin-deb)
+         **/
+        static void lireLiens(const char * deb, const char * fin, std::size_t nbNoeuds, std::vector<Lien> & liens);
 };
 
+//--------------------------------------------------------------------
+inline VueEnfants::iterator & VueEnfants::iterator::operator++()
+{
+    id = anc->cadet(id, parent);
+    return *this;
+}
+
+//--------------------------------------------------------------------
+template<class Visiteur>
+void Ancetres::pourChaqueRacine(Visiteur v) const
+{
+    for (PersonId id : idsRacines())
+        v(vue(id));
+}
+
+//--------------------------------------------------------------------
+template<class Visiteur>
+void Ancetres::pourChaqueIndividu(Visiteur v) const
+{
+    for (PersonId id = 0; id < noeuds.size(); ++id)
+        v(vue(id));
+}
+
+//--------------------------------------------------------------------
+template<class Visiteur>
+void Ancetres::pourChaqueSosa(PersonId id, unsigned int maxGen, Visiteur v) const
+{
+    // une génération après l'autre, chacune par un parcours en profondeur limité, le père avant la mère :
+    // les numéros sortent par ordre croissant, la première visite d'un ancêtre donne son plus petit numéro
+    Marquage & m = marquageDuFil();
+    const std::uint32_t vu = preparer(m,1);
+    if (m.sosa.size() < noeuds.size())
+        m.sosa.resize(noeuds.size());
+    maxGen = std::min(maxGen, 63u); // le numéro d'un ancêtre de génération 63 tient encore sur 64 bits
+    bool suite = true; // vrai tant qu'un ancêtre de la génération courante a un parent connu
+    for (std::uint32_t g = 0; g <= maxGen and suite; ++g) {
+        suite = false;
+        m.pileSosa.clear();
+        m.pileSosa.push_back(Marquage::Position{id, 0, 1});
+        while (!m.pileSosa.empty()) {
+            Marquage::Position p = m.pileSosa.back();
+            m.pileSosa.pop_back();
+            const Noeud & nd = noeuds[p.id];
+            if (p.gen == g) {
+                if (m.marque[p.id] != vu) {
+                    m.marque[p.id] = vu;
+                    m.sosa[p.id] = p.numero;
+                }
+                v(p.numero, p.id, m.sosa[p.id]);
+                suite = suite or nd.pere != -1 or nd.mere != -1;
+                continue;
+            }
+            if (nd.mere != -1)
+                m.pileSosa.push_back(Marquage::Position{(PersonId)nd.mere, p.gen+1, 2*p.numero+1});
+            if (nd.pere != -1)
+                m.pileSosa.push_back(Marquage::Position{(PersonId)nd.pere, p.gen+1, 2*p.numero});
+        }
+    }
+}
+
 /// surcharge de l'opérateur d'affichage << pour les Ancetres
 std::ostream & operator<<(std::ostream & os, const Ancetres & anc);
 
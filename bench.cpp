@@ -0,0 +1,264 @@
+/**
+ * @file bench.cpp
+ * @date 18/10/2026 Création
+ * @brief Programme de mesure des performances des classes Ancetres et Descendants
+ *
+ * usage : bench.exe registre... (voir generateur.cpp pour produire des registres de toutes tailles)
+ *
+ * pour chaque registre, chaque opération publique est répétée puis mesurée ; une ligne par mesure est écrite
+ * sur la sortie standard, champs séparés par des tabulations, après une ligne d'en-tête :
+ *   echelle      nombre d'individus du registre
+ *   operation    nom de l'opération mesurée
+ *   iterations   nombre de répétitions
+ *   ns_op        durée moyenne d'une répétition, en nanosecondes
+ *   allocs_op    nombre moyen d'appels à operator new par répétition
+ *   rss_max_ko   pic de mémoire résidente du processus depuis son lancement, en kilo-octets (0 si inconnu)
+**/
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+#include "ancetres.hpp"
+#include "descendants.hpp"
+#include "parente.hpp"
+#include "foretpartagee.hpp"
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+using namespace std;
+
+// compte des allocations : operator new est remplacé pour tout le programme
+static atomic<uint64_t> nbAllocations(0);
+
+void * operator new(size_t taille)
+{
+    ++nbAllocations;
+    if (void * p = malloc(taille ? taille : 1))
+        return p;
+    throw bad_alloc();
+}
+
+void * operator new[](size_t taille)
+{
+    return operator new(taille);
+}
+
+void operator delete(void * p) noexcept
+{
+    free(p);
+}
+
+void operator delete[](void * p) noexcept
+{
+    free(p);
+}
+
+// pic de mémoire résidente, en kilo-octets
+static long rssMax()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+#if defined(__APPLE__)
+    return ru.ru_maxrss / 1024; // en octets sous macOS
+#else
+    return ru.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+// reçoit les résultats, pour que le compilateur ne supprime pas les calculs mesurés
+static volatile size_t puits = 0;
+
+// répète f(i) pour i de 0 à iterations-1 et écrit la mesure
+template<class Operation>
+static void mesurer(size_t echelle, const char * operation, size_t iterations, Operation f)
+{
+    uint64_t a0 = nbAllocations.load();
+    chrono::steady_clock::time_point t0 = chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+        f(i);
+    chrono::steady_clock::time_point t1 = chrono::steady_clock::now();
+    uint64_t a1 = nbAllocations.load();
+    cout << echelle << '\t' << operation << '\t' << iterations << '\t'
+         << fixed << setprecision(1) << chrono::duration<double,nano>(t1-t0).count()/(double)iterations << '\t'
+         << setprecision(2) << (double)(a1-a0)/(double)iterations << '\t' << rssMax() << '\n' << flush;
+}
+
+// mesure toutes les opérations sur un registre
+static void mesurerRegistre(const string & fic)
+{
+    Ancetres anc(fic);
+    size_t n = anc.taille();
+    if (n == 0)
+        return;
+    // nombre de répétitions d'une opération rapide, et d'une opération en O(N)
+    const size_t RAPIDE = 100000, LENTE = max<size_t>(1, min<size_t>(100, 10000000/n));
+
+    // échantillons tirés une fois pour toutes : individus quelconques, et fondateurs (les premiers du registre)
+    mt19937 alea(42);
+    vector<PersonId> ids(4096), fondateurs(64);
+    for (PersonId & id : ids)
+        id = (PersonId)(alea() % n);
+    for (PersonId & id : fondateurs)
+        id = (PersonId)(alea() % max<size_t>(1, n/20));
+    vector<Individu> inds(ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
+        inds[i] = anc.individu(ids[i]);
+    auto id = [&ids](size_t i) { return ids[i % ids.size()]; };
+    auto ind = [&inds](size_t i) -> const Individu & { return inds[i % inds.size()]; };
+    vector<string> dates(inds.size());
+    for (size_t i = 0; i < inds.size(); ++i)
+        dates[i] = inds[i].dateEnChaine();
+
+    // chargement et instantanés
+    mesurer(n, "Ancetres(fichier)", 1, [&](size_t) { Ancetres a(fic); puits += a.taille(); });
+    mesurer(n, "Ancetres(fichier,1)", 1, [&](size_t) { Ancetres a(fic,1); puits += a.taille(); });
+    string bin = fic + ".bin";
+    mesurer(n, "sauvegarder", 1, [&](size_t) { puits += anc.sauvegarder(bin); });
+    mesurer(n, "charger", 1, [&](size_t) { Ancetres a; puits += a.charger(bin); });
+    remove(bin.c_str());
+    mesurer(n, "copie", LENTE, [&](size_t) { Ancetres a(anc); puits += a.taille(); });
+    // anc n'a encore servi à aucune requête : sa copie calcule toutes les générations
+    mesurer(n, "figer", 1, [&](size_t) {
+        Ancetres a(anc);
+        a.figer();
+        puits += a.generation(0);
+    });
+
+    // accès élémentaires
+    mesurer(n, "estPresent", RAPIDE, [&](size_t i) { puits += anc.estPresent(ind(i)); });
+    mesurer(n, "estPresent(parties)", RAPIDE, [&](size_t i) {
+        const Individu & x = ind(i); puits += anc.estPresent(x.sexe, x.nom.data(), x.nom.size(), dates[i % dates.size()].data()); });
+    mesurer(n, "identifiant", RAPIDE, [&](size_t i) { puits += anc.identifiant(ind(i)); });
+    mesurer(n, "individu", RAPIDE, [&](size_t i) { puits += anc.individu(id(i)).nom.size(); });
+    mesurer(n, "vue", RAPIDE, [&](size_t i) { puits += anc.vue(id(i)).lgNom; });
+    mesurer(n, "hasPere+getPere", RAPIDE, [&](size_t i) { puits += anc.hasPere(id(i)) ? anc.getPere(id(i)) : 0; });
+    mesurer(n, "hasMere+getMere", RAPIDE, [&](size_t i) { puits += anc.hasMere(id(i)) ? anc.getMere(id(i)) : 0; });
+    mesurer(n, "getPere(Individu)", RAPIDE, [&](size_t i) { puits += anc.hasPere(ind(i)) ? anc.getPere(ind(i)).nom.size() : 0; });
+    mesurer(n, "generation", RAPIDE, [&](size_t i) { puits += anc.generation(id(i)); });
+    mesurer(n, "enfants", RAPIDE, [&](size_t i) { puits += anc.enfants(id(i)).size(); });
+    mesurer(n, "nombreEnfants", RAPIDE, [&](size_t i) { puits += anc.nombreEnfants(id(i)); });
+    mesurer(n, "nbRacines", RAPIDE, [&](size_t) { puits += anc.nbRacines(); });
+
+    // parcours de toute la forêt
+    mesurer(n, "racines", LENTE, [&](size_t) { puits += anc.racines().size(); });
+    mesurer(n, "pourChaqueRacine", LENTE, [&](size_t) { anc.pourChaqueRacine([](const VueIndividu & v) { puits += v.lgNom; }); });
+    mesurer(n, "individus", LENTE, [&](size_t) { puits += anc.individus().size(); });
+    mesurer(n, "pourChaqueIndividu", LENTE, [&](size_t) { anc.pourChaqueIndividu([](const VueIndividu & v) { puits += v.lgNom; }); });
+    mesurer(n, "afficher", LENTE, [&](size_t) { ostringstream os; anc.afficher(os); puits += os.str().size(); });
+    mesurer(n, "exporter(TSV)", LENTE, [&](size_t) { ostringstream os; anc.exporter(os); puits += os.str().size(); });
+
+    // requêtes d'ancêtres
+    mesurer(n, "ancetresCommuns", 1000, [&](size_t i) { puits += anc.ancetresCommuns(id(2*i), id(2*i+1)).taille(); });
+    mesurer(n, "ancetresCommuns(Individu)", 1000, [&](size_t i) { puits += anc.ancetresCommuns(ind(2*i), ind(2*i+1)).taille(); });
+    vector<pair<PersonId,PersonId>> paires;
+    for (size_t i = 0; i < 1000; ++i)
+        paires.push_back(make_pair(id(2*i), id(2*i+1)));
+    mesurer(n, "ancetresCommuns(lot de 1000)", 1, [&](size_t) { puits += anc.ancetresCommuns(paires).size(); });
+    mesurer(n, "ancetres(10)", 1000, [&](size_t i) { puits += anc.ancetres(id(i), 10).taille(); });
+    mesurer(n, "pourChaqueSosa(10)", 1000, [&](size_t i) { anc.pourChaqueSosa(id(i), 10, [](uint64_t s, PersonId, uint64_t) { puits += s; }); });
+    mesurer(n, "afficherSosa(10)", 1000, [&](size_t i) { ostringstream os; anc.afficherSosa(os, id(i), 10); puits += os.str().size(); });
+    mesurer(n, "plusProchesAncetresCommuns", 1000, [&](size_t i) { puits += anc.plusProchesAncetresCommuns(id(2*i), id(2*i+1)).size(); });
+    {
+        // les mêmes requêtes sur une copie renumérotée (voir Ancetres::renumeroter)
+        Ancetres r(anc);
+        mesurer(n, "renumeroter", 1, [&](size_t) { puits += r.renumeroter(); });
+        r.figer();
+        vector<PersonId> idsR(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i)
+            idsR[i] = r.identifiant(inds[i]);
+        mesurer(n, "ancetresCommuns(renumerotee)", 1000, [&](size_t i) {
+            puits += r.ancetresCommuns(idsR[(2*i) % idsR.size()], idsR[(2*i+1) % idsR.size()]).taille(); });
+    }
+    {
+        // coefficients de parenté (voir Parente) : moteur neuf, puis paires déjà en cache
+        mesurer(n, "parente", 1000, [&](size_t i) { Parente p(anc); puits += (size_t)(p.parente(id(2*i), id(2*i+1)) * 1e6); });
+        mesurer(n, "consanguinites", 1, [&](size_t) { Parente p(anc); puits += p.consanguinites().size(); });
+        Parente p(anc);
+        for (size_t i = 0; i < 100; ++i)
+            p.parente(id(2*i), id(2*i+1));
+        mesurer(n, "parente(cache)", RAPIDE, [&](size_t i) { puits += (size_t)(p.parente(id(2*(i%100)), id(2*(i%100)+1)) * 1e6); });
+        p.consanguinites();
+        vector<PersonId> lot(ids.begin(), ids.begin() + (ptrdiff_t)min<size_t>(200, ids.size()));
+        mesurer(n, "matrice(200)", 1, [&](size_t) { puits += p.matrice(lot).size(); });
+    }
+
+    // modifications, sur une copie hors mesure
+    {
+        Ancetres a(anc);
+        vector<Individu> nouveaux;
+        for (size_t i = 0; i < 10000; ++i)
+            nouveaux.push_back(Individu(i % 2 ? 'm' : 'f', "Bench" + to_string(i), "2100-01-01"));
+        mesurer(n, "ajouter", nouveaux.size(), [&](size_t i) { puits += a.ajouter(nouveaux[i]); });
+        mesurer(n, "setPere", RAPIDE, [&](size_t i) { a.setPere(id(i), id(i+1)); });
+        mesurer(n, "setMere", RAPIDE, [&](size_t i) { a.setMere(id(i), id(i+1)); });
+    }
+    // publications d'une forêt partagée, chacune après l'ajout d'un individu rattaché à son père
+    {
+        ForetPartagee f(anc);
+        vector<Individu> nouveaux;
+        for (size_t i = 0; i < LENTE; ++i)
+            nouveaux.push_back(Individu(i % 2 ? 'm' : 'f', "Publie" + to_string(i), "2100-01-01"));
+        mesurer(n, "publier", LENTE, [&](size_t i) {
+            f.brouillon().setPere(f.brouillon().ajouter(nouveaux[i]), id(i));
+            puits += f.publier();
+        });
+    }
+    mesurer(n, "fusion(vide)", LENTE, [&](size_t) { Ancetres a; a.fusion(anc); puits += a.taille(); });
+    {
+        vector<Ancetres> copies(min<size_t>(LENTE, 8), anc); // copies préparées hors mesure, en nombre limité
+        mesurer(n, "fusion(identique)", copies.size(), [&](size_t i) { copies[i].fusion(anc); puits += copies[i].taille(); });
+    }
+    mesurer(n, "fusionner(4)", max<size_t>(1, LENTE/4), [&](size_t) {
+        puits += Ancetres::fusionner(vector<const Ancetres*>(4, &anc)).taille(); });
+
+    // descendants des fondateurs
+    auto fondateur = [&fondateurs](size_t i) { return fondateurs[i % fondateurs.size()]; };
+    mesurer(n, "Descendants(id,anc)", LENTE, [&](size_t i) { Descendants d(fondateur(i), anc); puits += d.nbDegres(); });
+    mesurer(n, "Descendants(Individu,anc)", LENTE, [&](size_t i) {
+        Descendants d(anc.individu(fondateur(i)), anc); puits += d.nbDegres(); });
+    Descendants d1(fondateur(0), anc), d2(fondateur(1), anc);
+    mesurer(n, "Descendants::estPresent", RAPIDE, [&](size_t i) { puits += d1.estPresent(ind(i)); });
+    mesurer(n, "Descendants::estPresent(parties)", RAPIDE, [&](size_t i) {
+        const Individu & x = ind(i); puits += d1.estPresent(x.sexe, x.nom.data(), x.nom.size(), dates[i % dates.size()].data()); });
+    mesurer(n, "auDegre(2)", LENTE, [&](size_t) { puits += d1.auDegre(2).size(); });
+    mesurer(n, "pourChaqueAuDegre(2)", LENTE, [&](size_t) { d1.pourChaqueAuDegre(2, [](const VueIndividu & v) { puits += v.date; }); });
+    mesurer(n, "effectifs", RAPIDE, [&](size_t) { puits += d1.effectifs().size(); });
+    mesurer(n, "tranche(1,3)", RAPIDE, [&](size_t) { puits += d1.tranche(1,3).size(); });
+    mesurer(n, "identifiants", RAPIDE, [&](size_t) { puits += d1.identifiants().size(); });
+    mesurer(n, "descendantsCommuns", LENTE, [&](size_t) { puits += d1.descendantsCommuns(d2).size(); });
+    mesurer(n, "Descendants::afficher", LENTE, [&](size_t) { ostringstream os; d1.afficher(os); puits += os.str().size(); });
+    {
+        Individu racine = anc.individu(fondateur(0));
+        Descendants d(racine);
+        vector<Individu> nouveaux;
+        for (size_t i = 0; i < 10000; ++i)
+            nouveaux.push_back(Individu(i % 2 ? 'm' : 'f', "Bench" + to_string(i), "2100-01-01"));
+        mesurer(n, "Descendants::ajouter", nouveaux.size(), [&](size_t i) {
+            d.ajouter(i == 0 ? racine : nouveaux[i/2], nouveaux[i]); });
+    }
+}
+
+/// Programme principal : mesure chaque registre passé en argument
+int main(int argc, char * argv[])
+{
+    if (argc < 2) {
+        cerr << "usage : " << argv[0] << " registre..." << endl;
+        return 1;
+    }
+    cout << "echelle\toperation\titerations\tns_op\tallocs_op\trss_max_ko\n";
+    for (int i = 1; i < argc; ++i)
+        mesurerRegistre(argv[i]);
+    return 0;
+}
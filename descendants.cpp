@@ -5,120 +5,205 @@
 **/
 
 #include "descendants.hpp" // pour le type Descendants
-#include <iostream>// EN AJOUTER SI BESOIN
-
-//--------------------------------------------------------------------
-Descendants::Noeud* Descendants::recuperer(Individu ind) {
-		std::set<Noeud*> parcoursVec,parcoursVecCopie;
-    Noeud* parcours = &racine;
-    parcoursVec.emplace(parcours);
-    while (parcoursVec.size() > 0) {
-        parcoursVecCopie = parcoursVec;
-        parcoursVec.clear();
-        for (Noeud* nd:parcoursVecCopie) {
-            if (nd->ind == ind) return nd;
-            parcours = nd->fils;
-            while (parcours != NULL) {
-                if (parcoursVec.count(parcours) == 0)
-                    parcoursVec.emplace(parcours);
-                parcours = parcours->frere;
-            }
-        }
+#include "tamponsortie.hpp" // pour le type TamponSortie
+#include <cstring> // pour std::memcmp
+#include <algorithm> // pour std::min, std::max et std::sort
+#include "intersection.hpp" // pour la fonction intersecter
+
+//--------------------------------------------------------------------
+Descendants::Noeud* Descendants::recuperer(const Individu & ind) {
+    return trouver(ind.sexe, ind.nom.data(), ind.nom.size(), ind.date);
+}
+
+//--------------------------------------------------------------------
+Descendants::Noeud* Descendants::trouver(char sexe, const char * nom, std::size_t lg, std::uint32_t date) const
+{
+    std::uint32_t k = indTOnd.trouver(Individu::hacher(sexe,nom,lg,date), [&](std::uint32_t j) {
+        const VueIndividu & ind = numerotes[j]->ind;
+        return ind.date == date and ind.sexe == sexe and ind.lgNom == lg and std::memcmp(ind.nom,nom,lg) == 0;
+    });
+    return k == TableIds::VIDE ? nullptr : numerotes[k];
+}
+
+//--------------------------------------------------------------------
+void Descendants::indexer(Noeud* nd)
+{
+    const VueIndividu & ind = nd->ind;
+    std::uint32_t k = (std::uint32_t)numerotes.size(); // numéro du nœud s'il est nouveau
+    std::uint32_t res = indTOnd.inserer(Individu::hacher(ind.sexe,ind.nom,ind.lgNom,ind.date), k, [&](std::uint32_t j) {
+        const VueIndividu & autre = numerotes[j]->ind;
+        return autre.date == ind.date and autre.sexe == ind.sexe and autre.lgNom == ind.lgNom
+               and std::memcmp(autre.nom,ind.nom,ind.lgNom) == 0;
+    });
+    if (res == k)
+        numerotes.push_back(nd);
+}
+
+//--------------------------------------------------------------------
+const char* Descendants::copierNom(const char * nom, std::size_t lg)
+{
+    if (noms.empty() || noms.back().capacity() - noms.back().size() < lg) {
+        noms.emplace_back();
+        noms.back().reserve(std::max<std::size_t>(4096, lg));
     }
-    return nullptr;
+    std::vector<char> & bloc = noms.back();
+    std::size_t debut = bloc.size();
+    bloc.insert(bloc.end(), nom, nom+lg); // sans dépasser la capacité : le bloc n'est pas réalloué
+    return bloc.data()+debut;
 }
 
 //--------------------------------------------------------------------
-void Descendants::detruire(Noeud* parcours) {
-	if (parcours != NULL) {
-		detruire(parcours->fils);
-		detruire(parcours->frere);
-		delete parcours->fils;
-		delete parcours->frere;
-	}
+Individu Descendants::individu(const VueIndividu & v)
+{
+    Individu ind;
+    ind.sexe = v.sexe;
+    ind.nom.assign(v.nom, v.lgNom);
+    ind.date = v.date;
+    return ind;
+}
+
+//--------------------------------------------------------------------
+Descendants::Noeud* Descendants::allouer(const VueIndividu & ind)
+{
+    if (arene.empty() || arene.back().size() == arene.back().capacity()) {
+        std::size_t cap = arene.empty() ? 16 : std::min<std::size_t>(4096, 2*arene.back().capacity());
+        arene.emplace_back();
+        arene.back().reserve(cap);
+    }
+    arene.back().push_back(Noeud{VueIndividu{ind.id, ind.sexe, copierNom(ind.nom,ind.lgNom), ind.lgNom, ind.date}, NULL, NULL});
+    return &arene.back().back();
 }
 
 
 //--------------------------------------------------------------------
 Descendants::Descendants(const Individu & ind)
 {
-    racine.ind = ind;
+    racine.ind = VueIndividu{TableIds::VIDE, ind.sexe, copierNom(ind.nom.data(),ind.nom.size()), ind.nom.size(), ind.date};
     racine.fils = NULL;
     racine.frere = NULL;
+    indexer(&racine);
+    ordreAJour = false;
+    espace = 0;
+    idsAJour = false;
 }
 
 //--------------------------------------------------------------------
-Descendants::Descendants(const Individu & ind, const Ancetres & anc):Descendants(ind)
+Descendants::Descendants(const Individu & ind, const Ancetres & anc):Descendants(anc.identifiant(ind),anc)
+{}
+
+//--------------------------------------------------------------------
+Descendants::Descendants(PersonId id, const Ancetres & anc):Descendants(anc.individu(id))
 {   
-    std::set<Individu> liste = anc.individus();
-    std::vector<Individu> degre, degreCopie;
-    degre.push_back(ind);
+    // parcours degré par degré des enfants de chaque individu, sans jamais parcourir toute la forêt
+    // un enfant dont les deux parents sont dans l'arbre n'y est rangé qu'une fois, sous le premier atteint
+    racine.ind.id = id;
+    espace = anc.espace();
+    // les individus atteints sont marqués d'une époque du marquage du fil : ni allocation par individu,
+    // ni remise à zéro d'un tableau de la taille de la forêt (voir Ancetres::marquageDuFil)
+    Ancetres::Marquage & m = Ancetres::marquageDuFil();
+    std::uint32_t vu = anc.preparer(m, 1);
+    std::vector<std::pair<PersonId,Noeud*>> degre, degreSuivant;
+    degre.push_back(std::make_pair(id,&racine));
+    m.marque[id] = vu;
     while (degre.size() > 0) {
-        degreCopie = degre;
-        degre.clear();
-        for (Individu indTest:degreCopie) {
-            for (Individu indEnf:liste) {
-                if((anc.hasMere(indEnf) && anc.getMere(indEnf) == indTest) || (anc.hasPere(indEnf) && anc.getPere(indEnf) == indTest)) {
-                	degre.push_back(indEnf);
-                	if (estPresent(indTest) && !estPresent(indEnf))
-                      ajouter(indTest,indEnf);
+        degreSuivant.clear();
+        for (const std::pair<PersonId,Noeud*> & par : degre) {
+            for (PersonId idEnf : anc.enfants(par.first)) {
+                if (m.marque[idEnf] != vu) {
+                    m.marque[idEnf] = vu;
+                    degreSuivant.push_back(std::make_pair(idEnf, inserer(par.second, anc.vue(idEnf))));
                 }
-        		}
-    		}
+            }
+        }
+        degre.swap(degreSuivant);
     }
 }
 
 //--------------------------------------------------------------------
 Descendants::~Descendants()
 {
-	if (racine.frere != NULL || racine.fils != NULL) {
-		detruire(racine.frere);
-		detruire(racine.fils);
-		delete racine.fils;
-		delete racine.frere;
-	}
+    // rien à parcourir : l'arène et la réserve des noms libèrent leurs blocs à leur destruction
 }
 
 //--------------------------------------------------------------------
-void Descendants::afficher(std::ostream & os) const
+void Descendants::aplatir() const
 {
-    std::set<const Noeud*> parcoursVec,parcoursVecCopie;
-    const Noeud* parcours = &racine;
-    parcoursVec.emplace(parcours);
-    while (parcoursVec.size() > 0) {
-        parcoursVecCopie = parcoursVec;
-        parcoursVec.clear();
-        for (const Noeud* nd:parcoursVecCopie) {
-            os << nd->ind << std::endl;
-            parcours = nd->fils;
-            while (parcours != NULL) {
-                if (parcoursVec.count(parcours) == 0)
-                    parcoursVec.emplace(parcours);
-                parcours = parcours->frere;
-            }
+    if (ordreAJour)
+        return;
+    // parcours en largeur : les enfants de chaque nœud se suivent, dans l'ordre de leurs parents
+    std::vector<const Noeud*> file(1,&racine);
+    file.reserve(numerotes.size());
+    filsDebut.clear();
+    for (std::size_t i = 0; i < file.size(); ++i) {
+        filsDebut.push_back((std::uint32_t)file.size());
+        for (const Noeud* parcours = file[i]->fils; parcours != NULL; parcours = parcours->frere)
+            file.push_back(parcours);
+    }
+    filsDebut.push_back((std::uint32_t)file.size());
+    ordre.resize(file.size());
+    for (std::size_t i = 0; i < file.size(); ++i)
+        ordre[i] = file[i]->ind;
+    // la génération k+1 est formée des enfants de la génération k
+    degreDebut.assign(1,0);
+    degreDebut.push_back(1);
+    while (degreDebut.back() < ordre.size())
+        degreDebut.push_back(filsDebut[degreDebut.back()]);
+    ordreAJour = true;
+}
+
+//--------------------------------------------------------------------
+void Descendants::trierIds() const
+{
+    if (idsAJour)
+        return;
+    idsTries.clear();
+    rangsTries.clear();
+    if (espace != 0) {
+        aplatir();
+        std::vector<std::pair<PersonId,std::uint32_t>> paires;
+        paires.reserve(ordre.size());
+        for (std::size_t i = 0; i < ordre.size(); ++i)
+            paires.push_back(std::make_pair(ordre[i].id, (std::uint32_t)i));
+        std::sort(paires.begin(), paires.end());
+        idsTries.reserve(paires.size());
+        rangsTries.reserve(paires.size());
+        for (const std::pair<PersonId,std::uint32_t> & p : paires) {
+            idsTries.push_back(p.first);
+            rangsTries.push_back(p.second);
         }
     }
-    
-    std::cout<<std::endl;
-
-		parcours = &racine;
-    parcoursVec.emplace(parcours);
-    while (parcoursVec.size() > 0) {
-        parcoursVecCopie = parcoursVec;
-        parcoursVec.clear();
-        for (const Noeud* nd:parcoursVecCopie) {
-            os << nd->ind << std::endl;
-            parcours = nd->fils;
-            if (parcours != NULL)
-                os << "-----> fils/filles :" << std::endl << "-----> ";
-            else
-                os << "      pas d'enfants" << std::endl;
-            while (parcours != NULL) {
-                os << parcours->ind << " | " << std::endl;
-                if (parcoursVec.count(parcours) == 0)
-                    parcoursVec.emplace(parcours);
-                parcours = parcours->frere;
-            }
+    idsAJour = true;
+}
+
+//--------------------------------------------------------------------
+VueIds Descendants::identifiants() const
+{
+    trierIds();
+    return VueIds{idsTries.data(), idsTries.data()+idsTries.size()};
+}
+
+//--------------------------------------------------------------------
+void Descendants::afficher(std::ostream & os) const
+{
+    aplatir();
+    TamponSortie t(os);
+    for (const VueIndividu & ind:ordre) {
+        t.individu(ind.sexe, ind.nom, ind.lgNom, ind.date);
+        t.caractere('\n');
+    }
+    t.caractere('\n');
+
+    static const char FILS[] = "-----> fils/filles :\n-----> ", AUCUN[] = "      pas d'enfants\n", SUITE[] = " | \n";
+    for (std::size_t i = 0; i < ordre.size(); ++i) {
+        t.individu(ordre[i].sexe, ordre[i].nom, ordre[i].lgNom, ordre[i].date);
+        t.caractere('\n');
+        if (filsDebut[i] != filsDebut[i+1])
+            t.texte(FILS, sizeof FILS - 1);
+        else
+            t.texte(AUCUN, sizeof AUCUN - 1);
+        for (std::uint32_t j = filsDebut[i]; j < filsDebut[i+1]; ++j) {
+            t.individu(ordre[j].sexe, ordre[j].nom, ordre[j].lgNom, ordre[j].date);
+            t.texte(SUITE, sizeof SUITE - 1);
         }
     }
 }
@@ -126,93 +211,119 @@ void Descendants::afficher(std::ostream & os) const
 //--------------------------------------------------------------------
 bool Descendants::estPresent(const Individu & ind) const
 {
-    if (racine.ind == ind)
-    	return true;
-   	else
-    	return estPresentBis(racine.fils,ind) || estPresentBis(racine.frere,ind);
+    return trouver(ind.sexe, ind.nom.data(), ind.nom.size(), ind.date) != nullptr;
 }
 
-bool Descendants::estPresentBis(const Noeud* indPtr, const Individu & ind ) const {
-		if (indPtr != NULL)
-			if (indPtr->ind == ind)
-				return true;
-			else
-				return estPresentBis(indPtr->fils,ind) || estPresentBis(indPtr->frere,ind);
-		else
-			return false;
+//--------------------------------------------------------------------
+bool Descendants::estPresent(char sexe, const char * nom, std::size_t lgNom, const char * date) const
+{
+    return trouver(sexe, nom, lgNom, Individu::coderDate(date,10)) != nullptr;
 }
 
 //--------------------------------------------------------------------
 void Descendants::ajouter(const Individu & par, const Individu & enf)
 {
-    Noeud* enfPoint = new Noeud{enf,NULL,NULL};
-    Noeud* ndPar, *parcours, *pred;
-    ndPar = recuperer(par);
+    inserer(recuperer(par), VueIndividu{TableIds::VIDE, enf.sexe, enf.nom.data(), enf.nom.size(), enf.date});
+    espace = 0; // enf n'a pas d'identifiant dans la forêt source
+}
+
+//--------------------------------------------------------------------
+Descendants::Noeud* Descendants::inserer(Noeud* ndPar, const VueIndividu & enf)
+{
+    Noeud* enfPoint = allouer(enf);
+    indexer(enfPoint);
+    ordreAJour = false;
+    idsAJour = false;
+    Noeud* parcours, *pred;
     if (ndPar->fils == nullptr) {
         ndPar->fils = enfPoint;
     } else {
     		parcours = ndPar->fils;
     		pred = parcours;
-    		while (parcours != NULL && parcours->ind.date > enf.date)
+    		// la fratrie est rangée de l'aîné au cadet
+    		while (parcours != NULL && !(enf.date < parcours->ind.date)) {
     				pred = parcours;
     				parcours = parcours->frere;
-    		if (pred == parcours) {
-	  	    	enfPoint->frere = pred->frere;
-  		    	pred->frere = enfPoint;
-  		  } else {
+    		}
+    		if (parcours == ndPar->fils) {
   		  		ndPar->fils = enfPoint;
-  		  		enfPoint->frere = pred;
+  		  		enfPoint->frere = parcours;
+  		  } else {
+	  	    	enfPoint->frere = parcours;
+  		    	pred->frere = enfPoint;
   		  }
     }
-    std::cout<<std::endl;
+    return enfPoint;
 }
 
 //--------------------------------------------------------------------
 std::set<Individu> Descendants::auDegre(unsigned int k) const
 {
-    unsigned int compt = 0;
     std::set<Individu> res;
-    std::set<const Noeud*> parcoursVec, parcoursVecCopie;
-    const Noeud* parcours = &racine;
-    parcoursVec.emplace(parcours);
-    while (parcoursVec.size() > 0 && compt < k+1) {
-        parcoursVecCopie = parcoursVec;
-        parcoursVec.clear();
-        for (const Noeud* nd:parcoursVecCopie) {
-        		if (compt == k && res.count(nd->ind) == 0)
-                    res.emplace(nd->ind);
-            parcours = nd->fils;
-            while (parcours != NULL) {
-                if (parcoursVec.count(parcours) == 0)
-                    parcoursVec.emplace(parcours);
-                parcours = parcours->frere;
-            }
-        }
-        compt++;
-    }
+    for (const VueIndividu & ind:tranche(k))
+        res.emplace(individu(ind));
+    return res;
+}
+
+//--------------------------------------------------------------------
+unsigned int Descendants::nbDegres() const
+{
+    aplatir();
+    return (unsigned int)degreDebut.size()-1;
+}
+
+//--------------------------------------------------------------------
+std::size_t Descendants::effectif(unsigned int k) const
+{
+    return tranche(k).size();
+}
+
+//--------------------------------------------------------------------
+std::vector<std::size_t> Descendants::effectifs() const
+{
+    aplatir();
+    std::vector<std::size_t> res(degreDebut.size()-1);
+    for (std::size_t k = 0; k < res.size(); ++k)
+        res[k] = degreDebut[k+1]-degreDebut[k];
     return res;
 }
 
+//--------------------------------------------------------------------
+Descendants::Tranche Descendants::tranche(unsigned int k) const
+{
+    return tranche(k,k);
+}
+
+//--------------------------------------------------------------------
+Descendants::Tranche Descendants::tranche(unsigned int kMin, unsigned int kMax) const
+{
+    aplatir();
+    // bornes ramenées aux générations existantes
+    std::size_t dernier = degreDebut.size()-1;
+    std::size_t deb = std::min<std::size_t>(kMin, dernier), fin = std::min<std::size_t>((std::size_t)kMax+1, dernier);
+    if (fin < deb)
+        fin = deb;
+    return Tranche{ordre.data()+degreDebut[deb], ordre.data()+degreDebut[fin]};
+}
+
 //--------------------------------------------------------------------
 std::set<Individu> Descendants::descendantsCommuns(const Descendants & des) const
 {
-		std::set<Individu> res;
-		std::set<const Noeud*> parcoursVec,parcoursVecCopie;
-    const Noeud* parcours = &des.racine;
-    parcoursVec.emplace(parcours);
-    while (parcoursVec.size() > 0) {
-        parcoursVecCopie = parcoursVec;
-        parcoursVec.clear();
-        for (const Noeud* nd:parcoursVecCopie) {
-            if (estPresent(nd->ind) && res.count(nd->ind)==0) res.emplace(nd->ind);
-            parcours = nd->fils;
-            while (parcours != NULL) {
-                if (parcoursVec.count(parcours) == 0)
-                    parcoursVec.emplace(parcours);
-                parcours = parcours->frere;
-            }
-        }
+    std::set<Individu> res;
+    if (espace != 0 and espace == des.espace) {
+        // même forêt source : un individu commun a le même identifiant dans les deux arbres
+        trierIds();
+        des.trierIds();
+        std::vector<std::uint32_t> pos(std::min(idsTries.size(), des.idsTries.size()));
+        std::size_t n = intersecter(idsTries.data(), idsTries.size(), des.idsTries.data(), des.idsTries.size(), pos.data());
+        for (std::size_t i = 0; i < n; ++i)
+            res.emplace_hint(res.end(), individu(ordre[rangsTries[pos[i]]]));
+        return res;
     }
+    des.aplatir();
+    for (const VueIndividu & ind:des.ordre)
+        if (trouver(ind.sexe, ind.nom, ind.lgNom, ind.date) != nullptr)
+            res.emplace(individu(ind));
     return res;
 }
 
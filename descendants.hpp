@@ -8,9 +8,12 @@
 #define _DESCENDANTS_HPP_
 
 #include <set> // pour le type std::set
+#include <vector> // pour le type std::vector
+#include <cstdint> // pour le type std::uint32_t
 #include <ostream> // pour le type std::ostream
 #include "individu.hpp" // pour le type Individu
 #include "ancetres.hpp" // pour le type Ancetres
+#include "tableids.hpp" // pour le type TableIds
 
 /**
  * @brief La classe Descendants représente un arbre généalogique de descendants
@@ -18,6 +21,43 @@
 class Descendants
 {
     public:
+        /**
+         * @brief Vue non possédante sur des générations consécutives d'un arbre, parcourable par une boucle for
+         * 
+         * les individus ne sont pas recopiés : le parcours balaie directement la disposition à plat de l'arbre,
+         * un tableau de VueIndividu dont les noms sont lus dans la réserve de l'arbre ; la vue reste valide
+         * jusqu'au prochain ajout dans l'arbre
+        **/
+        struct Tranche
+        {
+            /// Itérateur sur les individus d'une tranche
+            struct iterator
+            {
+                /// La position courante dans la disposition à plat
+                const VueIndividu * p;
+                /// L'individu courant, son identifiant dans la forêt source ou TableIds::VIDE
+                const VueIndividu & operator*() const { return *p; }
+                /// Passage à l'individu suivant
+                iterator & operator++() { ++p; return *this; }
+                /// Vrai ssi les positions diffèrent
+                bool operator!=(const iterator & it) const { return p != it.p; }
+                /// Vrai ssi les positions sont égales
+                bool operator==(const iterator & it) const { return p == it.p; }
+            };
+            /// Le premier individu de la tranche
+            const VueIndividu * debut;
+            /// La fin de la tranche (après le dernier individu)
+            const VueIndividu * fin;
+            /// Début du parcours
+            iterator begin() const { return iterator{debut}; }
+            /// Fin du parcours
+            iterator end() const { return iterator{fin}; }
+            /// Le nombre d'individus de la tranche
+            std::size_t size() const { return (std::size_t)(fin-debut); }
+            /// Vrai ssi la tranche est vide
+            bool empty() const { return debut == fin; }
+        };
+
         /**
          * @brief Constructeur d'un arbre pour un individu
          * @param ind L'individu racine
@@ -35,17 +75,42 @@ class Descendants
          * @pre ind est présent dans anc
          * @post L'arbre a ind pour racine et contient tous les descendants de ind présents dans anc
          * 
-         * @b Complexité -temporelle : O(nAnc*nbIndMaxDegre)
-         * 														 avec nAnc le nombre d'individus dans anc
-         *      											 nbIndMaxDegre le plus grand nombre d'ind par degré dans anc
-         								 -spatiale : O(nAnc + 2*nbIndMaxDegre + O(ajouter))
+         * @b Complexité -temporelle : O(nDes*nMaxFrere)
+         * 														 avec nDes le nombre de descendants de ind dans anc
+         *      											 nMaxFrere le plus grand nombre d'enfants d'une fratrie
+         *							 -spatiale : O(nDes)
          **/
         Descendants(const Individu & ind, const Ancetres & anc);
+
+        /**
+         * @brief Constructeur d'un arbre pour un identifiant d'individu d'une forêt d'ancêtres
+         * @param id L'identifiant de l'individu racine dans anc
+         * @param anc La forêt d'ancêtres
+         * @pre id < anc.taille()
+         * @post L'arbre a pour racine l'individu id et contient tous ses descendants présents dans anc
+         * 
+         * les enfants sont lus dans l'index des enfants de anc (voir Ancetres::enfants) ; les individus déjà
+         * atteints sont reconnus par le marquage par époque du fil appelant (voir Ancetres::marquageDuFil)
+         * 
+         * @b Complexité -temporelle : O(nDes*nMaxFrere)
+         * 														 avec nDes le nombre de descendants de id dans anc
+         *      											 nMaxFrere le plus grand nombre d'enfants d'une fratrie
+         *							 -spatiale : O(nDes), plus O(N) pour le marquage du fil à sa première requête
+         **/
+        Descendants(PersonId id, const Ancetres & anc);
         
+        /// Un arbre n'est pas copiable : ses nœuds appartiennent à son arène
+        Descendants(const Descendants &) = delete;
+        /// Un arbre n'est pas copiable : ses nœuds appartiennent à son arène
+        Descendants & operator=(const Descendants &) = delete;
+
         /**
          * @brief Destructeur
          * 
-         * @b Complexité -temporelle : O(detruire(Noeud*)) = O(1)
+         * les nœuds et leurs noms sont libérés bloc par bloc avec l'arène et la réserve des noms, sans parcourir
+         * l'arbre : un nœud n'a rien à détruire
+         * 
+         * @b Complexité -temporelle : Θ(nombre de blocs), soit O(n/4096 + log(n)) avec n le nombre de nœuds de l'arbre
          *							 -spatiale : O(1)
          **/
         ~Descendants();
@@ -54,11 +119,11 @@ class Descendants
          * @brief Affiche dans un flux de sortie (fichier ou écran)
          * @param os Le flux de sortie
          * 
-         * @b Complexité -temporelle : O(p*nMaxFrere*nIndMaxDegre)
-         *														 avec p la profondeur de Decendant
-         *      											 nMaxFrere le plus grand nombre d'enfants d'une fratrie
-         *      											 nIndMaxDegre le plus grand nombre d'ind par degré de Descendants
-         *							 -spatiale : O(2*nIndMaxDegre + 1)
+         * les individus sont affichés génération par génération, les fratries de l'aîné au cadet ;
+         * le texte est mis en forme dans un tampon (voir TamponSortie) et écrit par grands blocs
+         * 
+         * @b Complexité -temporelle : Θ(n) avec n le nombre de nœuds de l'arbre, plus O(aplatir)
+         *							 -spatiale : O(1)
          **/
         void afficher(std::ostream & os) const;
 
@@ -72,18 +137,31 @@ class Descendants
          **/
         bool estPresent(const Individu & ind) const;
 
+        /**
+         * @brief Indique si un individu, donné par ses parties, est présent dans l'arbre
+         * @param sexe Son sexe
+         * @param nom Le début de son nom
+         * @param lgNom La longueur de son nom
+         * @param date Sa date de naissance au format AAAA-MM-JJ (10 caractères, sans '\0' nécessaire)
+         * @return Vrai ssi l'individu est dans l'arbre
+         * 
+         * la recherche lit le nom et la date sur place, sans construire d'Individu ni allouer
+         * 
+         * @b Complexité -temporelle : Θ(lgNom)
+         *							 -spatiale : O(1)
+         **/
+        bool estPresent(char sexe, const char * nom, std::size_t lgNom, const char * date) const;
+
         /**
          * @brief Ajoute un nouvel enfant à un individu de l'arbre
          * @param par L'individu parent
          * @param enf Le nouvel individu enfant
          * @pre L'individu par est déjà dans l'arbre, pas l'individu enf
+         * @post L'arbre n'a plus d'identifiants (voir identifiants) : enf n'en a pas
          * 
-         * @b Complexité -temporelle : O(recuperer(Individu ind)) = O((p-pInd)*nMaxFrere*nIndMaxDegre)
-         *														 avec p la profondeur de Decendant
-         *														 pInd la profondeur de l'ind dans Descendants
-         *      											 nMaxFrere le plus grand nombre d'enfants d'une fratrie
-         *      											 nIndMaxDegre le plus grand nombre d'ind par degré de Descendants
-         *							 -spatiale : O( O(recuperer) + 2 )
+         * @b Complexité -temporelle : O(recuperer(Individu ind) + inserer) = O(nMaxFrere)
+         *      											 avec nMaxFrere le plus grand nombre d'enfants d'une fratrie
+         *							 -spatiale : O(1) amortie
          **/
         void ajouter(const Individu & par, const Individu & enf);
         
@@ -91,73 +169,233 @@ class Descendants
          * @brief Calcule l'ensemble des individus descendants de l'individu racine au degré k (1 = les enfants, 2 = les petits enfants, ...)
          * @return Les descendants au k-ième degré
          * 
-         * @b Complexité -temporelle : O((p-k)*nMaxFrere*nIndMaxDegre)
-         *														 avec p la profondeur de Decendant
-         *														 k le degré (donc la profondeur)
-         *      											 nMaxFrere le plus grand nombre d'enfants d'une fratrie
-         *      											 nIndMaxDegre le plus grand nombre d'ind par degré de Descendants
-         *							 -spatiale : O(nRes + 2*nIndMaxDegre + 1)
-         *													 avec nRes le nombre d'individus dans le set res
+         * @b Complexité -temporelle : O(nRes*log(nRes)) avec nRes le nombre de descendants au degré k, plus O(aplatir)
+         *							 -spatiale : O(nRes)
          **/
         std::set<Individu> auDegre(unsigned int k) const;
+
+        /**
+         * @brief Applique un visiteur à chaque descendant au degré k, sans allocation
+         * @param k Le degré (0 = la racine, 1 = les enfants, ...)
+         * @param v Le visiteur, appelé avec la VueIndividu de chaque individu du degré, dans l'ordre de la disposition à plat
+         * 
+         * @b Complexité -temporelle : Θ(effectif(k)) appels de v, plus O(aplatir)
+         *							 -spatiale : O(1)
+         **/
+        template<class Visiteur>
+        void pourChaqueAuDegre(unsigned int k, Visiteur v) const;
+
+        /**
+         * @brief Donne le nombre de générations de l'arbre, racine comprise
+         * @return 1 + le plus grand degré d'un descendant
+         * 
+         * @b Complexité -temporelle : Θ(1), plus O(aplatir)
+         *							 -spatiale : O(1)
+         **/
+        unsigned int nbDegres() const;
+
+        /**
+         * @brief Donne le nombre de descendants au degré k
+         * @param k Le degré (0 = la racine, 1 = les enfants, ...)
+         * @return Le nombre de descendants au degré k, 0 au-delà du dernier degré
+         * 
+         * @b Complexité -temporelle : Θ(1), plus O(aplatir)
+         *							 -spatiale : O(1)
+         **/
+        std::size_t effectif(unsigned int k) const;
+
+        /**
+         * @brief Donne le nombre de descendants à chaque degré
+         * @return effectif(k) pour k de 0 à nbDegres()-1
+         * 
+         * @b Complexité -temporelle : Θ(nbDegres()), plus O(aplatir)
+         *							 -spatiale : Θ(nbDegres())
+         **/
+        std::vector<std::size_t> effectifs() const;
+
+        /**
+         * @brief Accède aux descendants au degré k sans les recopier
+         * @param k Le degré (0 = la racine, 1 = les enfants, ...)
+         * @return La tranche des descendants au degré k, vide au-delà du dernier degré
+         * 
+         * @b Complexité -temporelle : Θ(1), plus O(aplatir) ; le parcours est en Θ(effectif(k))
+         *							 -spatiale : O(1)
+         **/
+        Tranche tranche(unsigned int k) const;
+
+        /**
+         * @brief Accède aux descendants des degrés kMin à kMax (inclus) sans les recopier
+         * @param kMin Le premier degré
+         * @param kMax Le dernier degré
+         * @return La tranche des descendants de ces degrés, génération par génération
+         * 
+         * les générations étant contiguës dans la disposition à plat, la tranche l'est aussi
+         * 
+         * @b Complexité -temporelle : Θ(1), plus O(aplatir) ; le parcours est en Θ(taille de la tranche)
+         *							 -spatiale : O(1)
+         **/
+        Tranche tranche(unsigned int kMin, unsigned int kMax) const;
+
+        /**
+         * @brief Accède aux identifiants des individus de l'arbre dans la forêt dont il est issu
+         * @return Les identifiants par ordre croissant, vide si l'arbre ne vient pas d'une forêt
+         *         ou s'il a été complété depuis par ajouter ; la vue reste valide jusqu'au prochain ajout
+         * 
+         * @b Complexité -temporelle : Θ(1), plus O(trierIds)
+         *							 -spatiale : O(1)
+         **/
+        VueIds identifiants() const;
         
         /**
          * @brief Calcule l'ensemble des descendants communs à deux arbres
          * @return L'ensemble des descendants communs
          * 
-         * @b Complexité -temporelle : O(p*nMaxFrere*nIndMaxDegre)
-         * 														 avec p la profondeur de Decendant
-         *  											     nMaxFrere le plus grand nombre d'enfants d'une fratrie
-         *   												   nIndMaxDegre le plus grand nombre d'ind par degré de Descendants
-         *							 -spatiale : O(nRes + 2*nIndMaxDegre + 1)
-         *													 avec nRes le nombre d'individus dans le set res
+         * si les deux arbres sont issus de la même forêt (voir Ancetres::espace), leurs identifiants triés
+         * sont intersectés (voir intersecter) ; sinon chaque nœud de des est cherché dans indTOnd
+         * 
+         * @b Complexité -temporelle : O(intersecter(n,m) + nRes*log(nRes)) entre arbres d'une même forêt,
+         *												 O(m + nRes*log(nRes)) sinon, avec n, m le nombre de nœuds de chaque arbre
+         *												 nRes le nombre d'individus dans le set res, plus O(trierIds) ou O(aplatir) pour des
+         *							 -spatiale : O(min(n,m))
          **/
         std::set<Individu> descendantsCommuns(const Descendants & des) const;
 
     private:
         // Type Nœud
+        // le nom est rangé dans la réserve des noms de l'arbre : un nœud n'a rien à détruire
         struct Noeud
         {
-            Individu ind; // l'individu représenté
+            VueIndividu ind; // l'individu représenté, ind.id son identifiant dans la forêt source ou TableIds::VIDE
             Noeud *fils, *frere; // enfant aîné, prochain dans la fratrie
         };
         // Attributs
         Noeud racine; // le nœud de l'individu racine
+        std::vector<std::vector<Noeud>> arene; // les autres nœuds, par blocs jamais réalloués une fois réservés
+        std::vector<std::vector<char>> noms; // les noms des nœuds, bout à bout, par blocs jamais réalloués non plus
+        TableIds indTOnd; // table associative Individu->numéro dans numerotes, hachée par Individu::hacher
+        std::vector<Noeud*> numerotes; // les nœuds rangés dans indTOnd, racine comprise, par numéro
+        // disposition à plat, génération par génération, recalculée après un ajout (voir aplatir)
+        mutable std::vector<VueIndividu> ordre; // les individus de l'arbre recopiés à la suite, la racine d'abord
+        mutable std::vector<std::uint32_t> filsDebut; // début des enfants de chaque nœud dans ordre, suivi de la fin
+        mutable std::vector<std::uint32_t> degreDebut; // début de chaque génération dans ordre, suivi de la fin
+        mutable bool ordreAJour; // faux si l'arbre a changé depuis le calcul de ordre
+        std::uint64_t espace; // espace d'identifiants de la forêt source (voir Ancetres::espace), 0 si aucun
+        // index des identifiants, recalculé après un ajout (voir trierIds)
+        mutable std::vector<PersonId> idsTries; // les identifiants des nœuds, par ordre croissant
+        mutable std::vector<std::uint32_t> rangsTries; // la position dans ordre de chaque identifiant de idsTries
+        mutable bool idsAJour; // faux si l'arbre a changé depuis le calcul de idsTries
         // Méthodes
+
+        /**
+         * @brief Recopie un nom dans la réserve des noms
+         * @param nom Le début du nom
+         * @param lg La longueur du nom
+         * @return La copie, valide jusqu'à la destruction de l'arbre
+         * 
+         * le nom est pris à la suite du dernier bloc ; un nouveau bloc d'au moins 4096 caractères n'est réservé
+         * que lorsque le nom n'y tient plus
+         * 
+         * @b Complexité -temporelle : Θ(lg) amortie
+         *							 -spatiale : Θ(lg) amortie
+         **/
+        const char* copierNom(const char * nom, std::size_t lg);
+
+        /**
+         * @brief Crée un nœud dans l'arène
+         * @param ind L'individu du nœud et son identifiant dans la forêt source, son nom recopié (voir copierNom)
+         * @return Le nœud créé, sans fils ni frère, valide jusqu'à la destruction de l'arbre
+         * 
+         * le nœud est pris à la suite du dernier bloc ; un nouveau bloc, deux fois plus grand (au plus 4096 nœuds),
+         * n'est réservé que lorsque le dernier est plein
+         * 
+         * @b Complexité -temporelle : Θ(ind.lgNom) amortie
+         *							 -spatiale : Θ(ind.lgNom) amortie
+         **/
+        Noeud* allouer(const VueIndividu & ind);
+
+        /**
+         * @brief Construit l'individu d'une vue
+         * @param v La vue
+         * @return L'individu, son nom recopié
+         * 
+         * @b Complexité Θ(v.lgNom)
+         **/
+        static Individu individu(const VueIndividu & v);
         
         /**
          * @brief Récupère le Noeud contenant l'individu recherché
          * @param ind L'individu à récupérer
          * @return Le pointeur sur Noeud si existant, nullptr sinon
          * 
-         * @b Complexité -temporelle : O((p-pInd*nMaxFrere*nIndMaxDegre)
-         * 														 avec p la profondeur de Decendant
-         *												 		 pInd la profondeur de l'ind dans Descendants
-         *      											 nMaxFrere le plus grand nombre d'enfants d'une fratrie
-         *      											 nIndMaxDegre le plus grand nombre d'ind par degré de Descendants
-         *							 -spatiale : O(2*nIndMaxDegre)
+         * @b Complexité -temporelle : O(1), par la table indTOnd
+         *							 -spatiale : O(1)
          **/
-        Noeud* recuperer(Individu ind);
-        
+        Noeud* recuperer(const Individu & ind);
+
         /**
-         * @brief Fonction aidant le Destructeur
-         * @param parcours le pointeur sur Noeud à supprimer
+         * @brief Recherche le Noeud d'un individu donné par ses parties
+         * @param sexe Son sexe
+         * @param nom Le début de son nom
+         * @param lg La longueur de son nom
+         * @param date Sa date de naissance codée
+         * @return Le pointeur sur Noeud si existant, nullptr sinon
          * 
-         * @b Complexité O(1)
+         * @b Complexité -temporelle : Θ(lg), par la table indTOnd
+         *							 -spatiale : O(1)
          **/
-        void detruire(Noeud* parcours);
-        
+        Noeud* trouver(char sexe, const char * nom, std::size_t lg, std::uint32_t date) const;
+
         /**
-         * @brief Fonction de recherche secondaire de estPresent
-         * @param ind L'individu à rechercher, indPtr le pointeur sur le Noeud à étudier
-         * @return Vrai ssi l'individu est dan le Noeud, sinon retourne (résultat du frère || résultat du fils), ou retourne faux si indPtr pointe sur NULL
+         * @brief Range un nœud dans la table indTOnd, sauf si son individu y est déjà
+         * @param nd Le nœud
          * 
-         * @b Complexité -temporelle : O(1)
+         * @b Complexité -temporelle : Θ(1) amortie
+         *							 -spatiale : O(1) amortie
+         **/
+        void indexer(Noeud* nd);
+
+        /**
+         * @brief Range un nouvel enfant dans la fratrie d'un nœud, de l'aîné au cadet
+         * @param ndPar Le nœud parent
+         * @param enf Le nouvel individu enfant et son identifiant dans la forêt source
+         * @return Le nœud créé pour enf, enregistré dans indTOnd
+         * 
+         * @b Complexité -temporelle : O(nMaxFrere)
          *							 -spatiale : O(1)
          **/
-        bool estPresentBis(const Noeud* indPtr, const Individu & ind ) const;
+        Noeud* inserer(Noeud* ndPar, const VueIndividu & enf);
+
+        /**
+         * @brief Recalcule la disposition à plat de l'arbre s'il a changé
+         * 
+         * les individus des nœuds sont recopiés en largeur dans ordre : chaque génération est contiguë, les enfants
+         * d'un individu aussi (voir filsDebut), et les parcours deviennent de simples balayages de ce tableau,
+         * sans passer par les nœuds de l'arène
+         * 
+         * @b Complexité -temporelle : Θ(n) si l'arbre a changé, Θ(1) sinon, avec n le nombre de nœuds de l'arbre
+         *							 -spatiale : Θ(n)
+         **/
+        void aplatir() const;
+
+        /**
+         * @brief Recalcule l'index trié des identifiants s'il a changé
+         * 
+         * l'index renvoie à la disposition à plat (voir aplatir), qu'il recalcule au besoin
+         * 
+         * @b Complexité -temporelle : Θ(n*log(n)) si l'arbre a changé, Θ(1) sinon, avec n le nombre de nœuds de l'arbre
+         *							 -spatiale : Θ(n)
+         **/
+        void trierIds() const;
 };
 
+//--------------------------------------------------------------------
+template<class Visiteur>
+void Descendants::pourChaqueAuDegre(unsigned int k, Visiteur v) const
+{
+    for (const VueIndividu & vue : tranche(k))
+        v(vue);
+}
+
 /// surcharge de l'opérateur d'affichage << pour les Descendants
 std::ostream & operator<<(std::ostream & os, const Descendants & anc);
 
@@ -0,0 +1,47 @@
+/**
+ * @file foretpartagee.cpp
+ * @date 18/10/2026 Création
+ * @brief Définition des méthodes de la classe ForetPartagee
+**/
+#include "foretpartagee.hpp" // pour le type ForetPartagee
+#include <utility> // pour std::move
+
+//--------------------------------------------------------------------
+ForetPartagee::ForetPartagee(Ancetres anc)
+: travail(std::move(anc)),
+  numero(1)
+{
+    travail.figer();
+    publiee = std::make_shared<const Version>(Version{numero, travail});
+}
+
+//--------------------------------------------------------------------
+ForetPartagee::Instantane ForetPartagee::lire() const
+{
+    return Instantane(std::atomic_load(&publiee));
+}
+
+//--------------------------------------------------------------------
+std::uint64_t ForetPartagee::version() const
+{
+    return std::atomic_load(&publiee)->numero;
+}
+
+//--------------------------------------------------------------------
+Ancetres & ForetPartagee::brouillon()
+{
+    return travail;
+}
+
+//--------------------------------------------------------------------
+std::uint64_t ForetPartagee::publier()
+{
+    std::lock_guard<std::mutex> verrou(publication);
+    // la copie est figée avant d'être visible : ses lecteurs ne déclenchent plus aucun calcul ;
+    // elle partage les segments du brouillon, que le brouillon dupliquera avant de les modifier
+    travail.figer();
+    // le numéro est publié avec la forêt, dans le même pointeur : un lecteur ne voit jamais l'un sans l'autre
+    std::shared_ptr<const Version> nouvelle = std::make_shared<const Version>(Version{numero+1, travail});
+    std::atomic_store(&publiee, nouvelle);
+    return ++numero;
+}
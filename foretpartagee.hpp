@@ -0,0 +1,127 @@
+/**
+ * @file foretpartagee.hpp
+ * @date 18/10/2026 Création
+ * @brief Définition de la classe ForetPartagee
+**/
+
+#ifndef _FORETPARTAGEE_HPP_
+#define _FORETPARTAGEE_HPP_
+
+#include <memory> // pour le type std::shared_ptr
+#include <mutex> // pour le type std::mutex
+#include <utility> // pour std::move
+#include <cstdint> // pour le type std::uint64_t
+#include "ancetres.hpp" // pour le type Ancetres
+
+/**
+ * @brief La classe ForetPartagee partage une forêt d'ancêtres entre des lecteurs concurrents et un rédacteur
+ *
+ * les lecteurs obtiennent une version publiée de la forêt, figée (voir Ancetres::figer) et jamais modifiée :
+ * ils l'interrogent sans aucun verrou, aussi longtemps qu'ils la gardent, pendant que le rédacteur modifie son brouillon.
+ * Obtenir la version n'est pas sans verrou au sens strict : std::atomic_load et std::atomic_store sur un
+ * std::shared_ptr sont protégés par un verrou interne de la bibliothèque standard, tenu le temps d'échanger le
+ * pointeur ; un lecteur n'attend donc jamais ni le rédacteur, ni la recopie d'une publication
+ *
+ * une publication copie le brouillon dans une nouvelle version et la substitue atomiquement à l'ancienne,
+ * libérée quand son dernier lecteur la lâche. La copie partage les segments du brouillon (voir Segments) :
+ * seule la table des segments est recopiée, et le brouillon ne duplique ensuite que les segments qu'il modifie
+**/
+class ForetPartagee
+{
+    private:
+        // Une version publiée : la forêt et son numéro, publiés ensemble
+        struct Version {
+            std::uint64_t numero;
+            Ancetres foret;
+        };
+
+    public:
+        /// Une version publiée, immuable, de la forêt, qui connaît son numéro
+        class Instantane
+        {
+            public:
+                /// Un instantané vide, qui ne désigne aucune version
+                Instantane() = default;
+                /// La forêt de la version
+                const Ancetres & operator*() const { return v->foret; }
+                /// Accès aux méthodes de la forêt de la version
+                const Ancetres * operator->() const { return &v->foret; }
+                /// Le numéro de la version, celui que rendait publier
+                std::uint64_t version() const { return v->numero; }
+                /// Vrai ssi l'instantané désigne une version
+                explicit operator bool() const { return v != nullptr; }
+            private:
+                friend class ForetPartagee;
+                explicit Instantane(std::shared_ptr<const Version> ver) : v(std::move(ver)) {}
+                std::shared_ptr<const Version> v; // la version, libérée avec son dernier instantané
+        };
+
+        /**
+         * @brief Constructeur à partir d'une forêt initiale
+         * @param anc La forêt, qui devient à la fois le brouillon et la version 1
+         *
+         * @b Complexité -temporelle : Θ(N) avec N le nombre d'individus de anc
+         *							 -spatiale : Θ(N)
+         **/
+        explicit ForetPartagee(Ancetres anc = Ancetres());
+
+        /// Une forêt partagée n'est pas copiable : ses lecteurs et son rédacteur la désignent
+        ForetPartagee(const ForetPartagee &) = delete;
+        /// Une forêt partagée n'est pas copiable : ses lecteurs et son rédacteur la désignent
+        ForetPartagee & operator=(const ForetPartagee &) = delete;
+
+        /**
+         * @brief Donne la dernière version publiée, depuis n'importe quel fil
+         * @return La version, valide et inchangée tant que l'appelant la garde
+         *
+         * @b Complexité Θ(1) : le verrou interne de std::atomic_load n'est tenu que pour copier le pointeur,
+         *               jamais pendant une modification ou une publication du rédacteur
+         **/
+        Instantane lire() const;
+
+        /**
+         * @brief Donne le numéro de la dernière version publiée
+         * @return Le numéro, 1 pour la forêt initiale, augmenté de 1 à chaque publication
+         *
+         * le numéro est lu dans la version publiée elle-même : il n'est jamais en retard sur lire().
+         * Pour connaître le numéro d'une version obtenue, Instantane::version
+         *
+         * @b Complexité Θ(1)
+         **/
+        std::uint64_t version() const;
+
+        /**
+         * @brief Accède au brouillon du rédacteur
+         * @return La forêt à modifier avant la prochaine publication
+         * @pre Un seul fil à la fois utilise le brouillon et publie
+         *
+         * les modifications n'ont aucun effet sur les versions publiées
+         *
+         * @b Complexité Θ(1)
+         **/
+        Ancetres & brouillon();
+
+        /**
+         * @brief Publie le brouillon comme nouvelle version
+         * @return Le numéro de la version publiée
+         * @pre Un seul fil à la fois utilise le brouillon et publie
+         *
+         * le brouillon est figé puis copié en partageant ses segments ; après la publication, la première écriture
+         * du brouillon dans un segment le duplique (2^10 éléments), les suivantes non. Figer ne coûte rien tant
+         * que setPere et setMere ont tenu les générations à jour (voir Ancetres::generation)
+         *
+         * @b Complexité -temporelle : Θ(N/2^10) avec N le nombre d'individus du brouillon, plus Θ(N) si les générations
+         *													 sont à recalculer (longue propagation, cycle, chargement)
+         *							 -spatiale : Θ(N/2^10)
+         **/
+        std::uint64_t publier();
+
+    private:
+        // Attributs
+        Ancetres travail; // le brouillon du rédacteur
+        std::shared_ptr<const Version> publiee; // la dernière version publiée, lue et remplacée par std::atomic_load et std::atomic_store
+        std::uint64_t numero; // le numéro de la dernière version publiée, gardé par publication
+        std::mutex publication; // garde contre deux publications simultanées
+};
+
+#endif // _FORETPARTAGEE_HPP_
@@ -0,0 +1,134 @@
+/**
+ * @file generateur.cpp
+ * @date 18/10/2026 Création
+ * @brief Programme de génération de registres généalogiques synthétiques
+ *
+ * usage : generateur.exe sortie [population] [générations] [enfants] [manquants] [implexe] [graine]
+ *   population   nombre d'individus visé (10000 par défaut)
+ *   générations  nombre de générations (10 par défaut)
+ *   enfants      nombre moyen d'enfants par couple, qui règle la croissance d'une génération à la suivante (2.5 par défaut)
+ *   manquants    probabilité qu'un parent soit inconnu (0.1 par défaut)
+ *   implexe      probabilité qu'un enfant ait pour parents deux cousins, ou deux demi-frère et sœur (0.05 par défaut)
+ *   graine       graine du générateur pseudo-aléatoire (1 par défaut) : une même graine donne le même registre
+ *
+ * le registre écrit a le format lu par Ancetres::Ancetres : les individus (sexe, nom, date) par génération,
+ * des plus anciens aux plus récents, puis les liens (numéro, père, mère), 0 désignant un parent inconnu
+**/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <cstdlib>
+#include <cstdint>
+#include <cmath>
+using namespace std;
+
+// syllabes des noms ; chaque nom se termine par le numéro de l'individu, ce qui le rend unique
+static const char * const SYLLABES[] = {"ma","ri","lo","be","jan","ne","to","ca","mil","le","ro","se","dre","an","li","su"};
+
+// forme le nom de l'individu i
+static string nommer(uint32_t i, mt19937 & alea)
+{
+    string nom;
+    unsigned int nb = 2 + alea() % 2;
+    for (unsigned int k = 0; k < nb; ++k)
+        nom += SYLLABES[alea() % 16];
+    nom[0] = (char)(nom[0] - 'a' + 'A');
+    return nom + to_string(i);
+}
+
+/// Programme principal : écrit un registre synthétique selon les paramètres de la ligne de commande
+int main(int argc, char * argv[])
+{
+    if (argc < 2) {
+        cerr << "usage : " << argv[0] << " sortie [population] [générations] [enfants] [manquants] [implexe] [graine]" << endl;
+        return 1;
+    }
+    uint32_t population = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 10) : 10000;
+    unsigned int nbGen = argc > 3 ? (unsigned int)strtoul(argv[3], nullptr, 10) : 10;
+    double enfants = argc > 4 ? atof(argv[4]) : 2.5;
+    double manquants = argc > 5 ? atof(argv[5]) : 0.1;
+    double implexe = argc > 6 ? atof(argv[6]) : 0.05;
+    mt19937 alea(argc > 7 ? (uint32_t)strtoul(argv[7], nullptr, 10) : 1);
+    if (population == 0 or nbGen == 0 or enfants <= 0) {
+        cerr << "population, générations et enfants doivent être positifs" << endl;
+        return 1;
+    }
+    uniform_real_distribution<double> uniforme(0.0, 1.0);
+
+    // effectif de chaque génération : chaque génération compte enfants/2 fois la précédente
+    double r = enfants/2, total = 0;
+    for (unsigned int g = 0; g < nbGen; ++g)
+        total += pow(r, (double)g);
+    vector<uint32_t> effectif(nbGen);
+    uint32_t n = 0;
+    for (unsigned int g = 0; g < nbGen; ++g) {
+        effectif[g] = g+1 < nbGen ? max<uint32_t>(2, (uint32_t)(population*pow(r,(double)g)/total)) : max<uint32_t>(2, population > n ? population-n : 0);
+        n += effectif[g];
+    }
+
+    // individus et liens ; les individus d'une génération sont contigus
+    vector<char> sexe(n);
+    vector<uint32_t> pere(n, 0), mere(n, 0); // numéros à partir de 1, 0 si inconnu
+    vector<vector<uint32_t>> enfantsDe(n+1); // enfants de chaque numéro, pour chercher des cousins
+    vector<uint32_t> debut(nbGen+1, 0);
+    for (unsigned int g = 0; g < nbGen; ++g)
+        debut[g+1] = debut[g] + effectif[g];
+
+    ofstream os(argv[1]);
+    if (!os) {
+        cerr << "sortie impossible : " << argv[1] << endl;
+        return 1;
+    }
+    for (unsigned int g = 0; g < nbGen; ++g) {
+        vector<uint32_t> hommes, femmes;
+        if (g > 0)
+            for (uint32_t i = debut[g-1]; i < debut[g]; ++i)
+                (sexe[i] == 'm' ? hommes : femmes).push_back(i+1);
+        for (uint32_t i = debut[g]; i < debut[g+1]; ++i) {
+            sexe[i] = alea() % 2 ? 'm' : 'f';
+            if (hommes.empty() or femmes.empty())
+                continue; // fondateurs
+            uint32_t p = hommes[alea() % hommes.size()], m = 0;
+            // implexe : la mère est prise parmi les petits-enfants d'un grand-parent du père (une cousine),
+            // ou à défaut parmi les enfants d'un parent du père (une sœur ou demi-sœur)
+            if (uniforme(alea) < implexe) {
+                uint32_t par = alea() % 2 ? pere[p-1] : mere[p-1];
+                uint32_t gp = par == 0 ? 0 : (alea() % 2 ? pere[par-1] : mere[par-1]);
+                if (gp != 0) {
+                    const vector<uint32_t> & oncles = enfantsDe[gp];
+                    par = oncles[alea() % oncles.size()];
+                }
+                if (par != 0)
+                    for (uint32_t c : enfantsDe[par])
+                        if (sexe[c-1] == 'f') {
+                            m = c;
+                            break;
+                        }
+            }
+            if (m == 0)
+                m = femmes[alea() % femmes.size()];
+            if (uniforme(alea) >= manquants) {
+                pere[i] = p;
+                enfantsDe[p].push_back(i+1);
+            }
+            if (uniforme(alea) >= manquants) {
+                mere[i] = m;
+                enfantsDe[m].push_back(i+1);
+            }
+        }
+        // naissances étalées sur 25 ans par génération, à partir de 1500
+        for (uint32_t i = debut[g]; i < debut[g+1]; ++i) {
+            unsigned int an = min(9999u, 1500 + 25*g + (unsigned int)(alea() % 25));
+            unsigned int mois = 1 + (unsigned int)(alea() % 12), jour = 1 + (unsigned int)(alea() % 28);
+            os << sexe[i] << '\t' << nommer(i+1, alea) << '\t' << an << '-' << (mois < 10 ? "0" : "") << mois
+               << '-' << (jour < 10 ? "0" : "") << jour << '\n';
+        }
+    }
+    for (uint32_t i = 0; i < n; ++i)
+        if (pere[i] != 0 or mere[i] != 0)
+            os << i+1 << '\t' << pere[i] << '\t' << mere[i] << '\n';
+    return os.good() ? 0 : 1;
+}
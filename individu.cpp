@@ -5,34 +5,78 @@
 **/
 
 #include "individu.hpp" // pour le type Individu
+#include "tableids.hpp" // pour les fonctions de hachage de TableIds
+#include <stdexcept> // pour le type std::invalid_argument
 
 //--------------------------------------------------------------------
-std::string Individu::enChaine() const 
-{ 
-    return std::string() + sexe + "\t" + nom + "\t" + date; 
+Individu::Individu()
+: sexe(0), nom(), date(0)
+{}
+
+//--------------------------------------------------------------------
+Individu::Individu(char s, const std::string & n, const std::string & d)
+: sexe(s), nom(n), date(coderDate(d.data(),d.size()))
+{}
+
+//--------------------------------------------------------------------
+std::uint32_t Individu::coderDate(const char * d, std::size_t lg)
+{
+    // AAAA-MM-JJ : chiffres aux positions 0-3, 5-6 et 8-9 ; mois et jour doivent tenir dans leurs 4 et 5 bits,
+    // sans quoi deux dates écrites différemment auraient le même code
+    bool valide = lg == 10 and d[4] == '-' and d[7] == '-';
+    for (std::size_t i = 0; valide and i < 10; ++i)
+        valide = i == 4 or i == 7 or (d[i] >= '0' and d[i] <= '9');
+    std::uint32_t an = 0, mois = 0, jour = 0;
+    if (valide) {
+        an = (std::uint32_t)( (d[0]-'0')*1000 + (d[1]-'0')*100 + (d[2]-'0')*10 + (d[3]-'0') );
+        mois = (std::uint32_t)( (d[5]-'0')*10 + (d[6]-'0') );
+        jour = (std::uint32_t)( (d[8]-'0')*10 + (d[9]-'0') );
+    }
+    if (mois < 1 or mois > 12 or jour < 1 or jour > 31)
+        throw std::invalid_argument("date de naissance mal formée : " + std::string(d, lg < 10 ? lg : 10));
+    return an<<9 | mois<<5 | jour;
 }
 
 //--------------------------------------------------------------------
-bool Individu::operator==(const Individu & ind) const
+std::uint64_t Individu::hacher(char s, const char * n, std::size_t lg, std::uint32_t d)
 {
-    return (sexe==ind.sexe and nom==ind.nom and date==ind.date); 
+    return TableIds::melanger(TableIds::hacher(n, lg) ^ (d<<8 | (unsigned char)s));
 }
 
 //--------------------------------------------------------------------
-void Individu::operator=(const Individu & ind)
+std::string Individu::dateEnChaine() const
+{
+    std::uint32_t an = date>>9, mois = (date>>5) & 0xF, jour = date & 0x1F;
+    char d[10] = { (char)('0'+an/1000), (char)('0'+an/100%10), (char)('0'+an/10%10), (char)('0'+an%10), '-',
+                   (char)('0'+mois/10), (char)('0'+mois%10), '-',
+                   (char)('0'+jour/10), (char)('0'+jour%10) };
+    return std::string(d,10);
+}
+
+//--------------------------------------------------------------------
+std::uint32_t Individu::cle() const
+{
+    return date<<8 | (unsigned char)sexe;
+}
+
+//--------------------------------------------------------------------
+std::string Individu::enChaine() const 
+{ 
+    return std::string() + sexe + "\t" + nom + "\t" + dateEnChaine(); 
+}
+
+//--------------------------------------------------------------------
+bool Individu::operator==(const Individu & ind) const
 {
-    sexe=ind.sexe;
-    nom=ind.nom;
-    date=ind.date; 
+    return (date==ind.date and sexe==ind.sexe and nom==ind.nom); 
 }
 
 //--------------------------------------------------------------------
 bool Individu::operator<(const Individu & ind) const
 {
-    // comparaison lexicographique, par année, puis mois, puis jour, puis sexe, puis nom
-    return ( date < ind.date ) 
-        or ( date == ind.date and ( sexe < ind.sexe 
-                               or ( sexe == ind.sexe and nom < nom ) ) ) ; 
+    // comparaison par la clé entière (date puis sexe), puis par nom
+    return ( cle() < ind.cle() ) 
+        or ( cle() == ind.cle() and nom < ind.nom ) ; 
 }
 
 //--------------------------------------------------------------------
@@ -47,9 +91,6 @@ namespace std
 {
     hash<Individu>::result_type hash<Individu>::operator()(argument_type const& ind) const
     {
-        hash<Individu>::result_type const s ( std::hash<char>{}(ind.sexe) );
-        hash<Individu>::result_type const n ( std::hash<std::string>{}(ind.nom) );
-        hash<Individu>::result_type const d ( std::hash<std::string>{}(ind.date) );
-        return s ^ (n ^ (d << 1) << 1);
+        return (hash<Individu>::result_type)Individu::hacher(ind.sexe, ind.nom.data(), ind.nom.size(), ind.date);
     }
 }
@@ -8,11 +8,15 @@
 #define _INDIVIDU_HPP_
 
 #include <string> // pour le type std::string et ses opérations
+#include <cstdint> // pour le type std::uint32_t
 
 /**
  * @brief La classe Individu représente les informations liées à un individu
  * 
  * les attributs sont directement accessibles (~enregistrement) par simplicité
+ * 
+ * la date est codée une fois pour toutes en un entier (AAAA<<9 | MM<<5 | JJ) :
+ * comparaisons et hachage se font sur des entiers, la chaîne n'est reconstruite que pour l'affichage
 **/ 
 struct Individu
 {
@@ -21,8 +25,70 @@ struct Individu
     char sexe;
     /// Le nom de l'individu, suite de lettres sans espace
     std::string nom;
-    /// La date de naissance de l'individu au format AAAA-MM-JJ
-    std::string date;
+    /// La date de naissance de l'individu, codée par Individu::coderDate
+    std::uint32_t date;
+
+    /**
+     * @brief Constructeur d'un individu indéterminé
+     * 
+     * @b Complexité Θ(1)
+     **/
+    Individu();
+
+    /**
+     * @brief Constructeur à partir des informations d'un individu
+     * @param s Le sexe, 'f' ou 'm'
+     * @param n Le nom
+     * @param d La date de naissance au format AAAA-MM-JJ
+     * @throw std::invalid_argument si la date est mal formée (voir coderDate)
+     * 
+     * @b Complexité Θ(1)
+     **/
+    Individu(char s, const std::string & n, const std::string & d);
+
+    /**
+     * @brief Code une date de naissance en entier
+     * @param d La date au format AAAA-MM-JJ
+     * @param lg Le nombre de caractères de d
+     * @return La date codée AAAA<<9 | MM<<5 | JJ, croissante avec la date
+     * @throw std::invalid_argument si d n'a pas exactement 10 caractères, ses tirets et ses chiffres en place,
+     *        ou si le mois n'est pas entre 1 et 12 ou le jour entre 1 et 31 ; aucun caractère au-delà
+     *        des lg premiers n'est lu
+     * 
+     * @b Complexité Θ(1)
+     **/
+    static std::uint32_t coderDate(const char * d, std::size_t lg);
+
+    /**
+     * @brief Hache un individu donné par ses parties, sans construire d'Individu
+     * @param s Le sexe
+     * @param n Le début du nom
+     * @param lg La longueur du nom
+     * @param d La date de naissance codée
+     * @return Un hachage dont chaque bit dépend du nom, du sexe et de la date
+     * 
+     * le nom est haché octet par octet puis mélangé à la clé (voir cle) : deux homonymes nés le même jour,
+     * ou deux individus nés à des dates voisines, n'ont pas de hachages proches
+     * 
+     * @b Complexité Θ(lg)
+     **/
+    static std::uint64_t hacher(char s, const char * n, std::size_t lg, std::uint32_t d);
+
+    /**
+     * @brief Reconstruit la date de naissance au format AAAA-MM-JJ
+     * @return La chaîne de la date
+     * 
+     * @b Complexité Θ(1)
+     **/
+    std::string dateEnChaine() const;
+
+    /**
+     * @brief Clé de tri de taille fixe combinant date de naissance et sexe
+     * @return date<<8 | sexe, qui ordonne par date puis par sexe
+     * 
+     * @b Complexité Θ(1)
+     **/
+    std::uint32_t cle() const;
 
     /**
      * @brief Méthode pour affichage et hachage
@@ -41,19 +107,26 @@ struct Individu
      **/
     bool operator==(const Individu & ind) const;
 
-		/**
+    /// Copie membre à membre
+    Individu(const Individu &) = default;
+    /// Déplacement membre à membre : le nom n'est pas recopié
+    Individu(Individu &&) = default;
+
+    /**
      * @brief Assignation d'individu
      * @param ind L'individu à recopier
+     * @return L'instance
      * 
-     * @b Complexité Θ(1)
+     * @b Complexité Θ(longueur du nom)
      **/
-    void operator=(const Individu & ind);
-
+    Individu & operator=(const Individu & ind) = default;
+    /// Assignation par déplacement : le nom n'est pas recopié
+    Individu & operator=(Individu && ind) = default;
 
     /**
      * @brief Comparateur d'individus pour l'inégalité
      * @param ind L'individu auquel se comparer
-     * @return Vrai ssi l'instance a une date de naissance antérieure à ind
+     * @return Vrai ssi l'instance précède ind par date de naissance, puis sexe, puis nom
      * 
      * @b Complexité Θ(1)
      **/
@@ -68,6 +141,7 @@ namespace std
 {
     /**
      * Spécialisation de std::hash pour pouvoir utiliser des Individus dans les containers utilisant une fonction de hachage
+     * (voir Individu::hacher)
     **/ 
     template<> struct hash<Individu>
     {
@@ -0,0 +1,122 @@
+/**
+ * @file ingestion.cpp
+ * @date 18/10/2026 Création
+ * @brief Définition des méthodes de la classe Ingestion
+**/
+#include "ingestion.hpp" // pour le type Ingestion
+#include <cstring> // pour std::memcmp
+#include <cassert> // pour les assertions
+
+//--------------------------------------------------------------------
+Ingestion::Ingestion()
+: fragments(new Fragment[NB_FRAGMENTS]),
+  blocs(new std::atomic<Case*>[NB_BLOCS]),
+  prochain(0)
+{
+    for (std::size_t b = 0; b < NB_BLOCS; ++b)
+        blocs[b].store(nullptr);
+}
+
+//--------------------------------------------------------------------
+Ingestion::~Ingestion()
+{
+    for (std::size_t b = 0; b < NB_BLOCS; ++b)
+        delete[] blocs[b].load();
+}
+
+//--------------------------------------------------------------------
+Ingestion::Case & Ingestion::caseDe(PersonId id)
+{
+    std::atomic<Case*> & bloc = blocs[id >> BITS_BLOC];
+    Case * cases = bloc.load(std::memory_order_acquire);
+    if (cases == nullptr) {
+        // plusieurs fils peuvent créer le même bloc : un seul est gardé
+        Case * nouveau = new Case[(std::size_t)1 << BITS_BLOC];
+        for (std::size_t i = 0; i < ((std::size_t)1 << BITS_BLOC); ++i) {
+            nouveau[i].pere.store(-1, std::memory_order_relaxed);
+            nouveau[i].mere.store(-1, std::memory_order_relaxed);
+        }
+        if (bloc.compare_exchange_strong(cases, nouveau, std::memory_order_acq_rel))
+            cases = nouveau;
+        else
+            delete[] nouveau;
+    }
+    return cases[id & (((PersonId)1 << BITS_BLOC)-1)];
+}
+
+//--------------------------------------------------------------------
+PersonId Ingestion::ajouter(const Individu & ind)
+{
+    const char * nom = ind.nom.data();
+    std::uint32_t lg = (std::uint32_t)ind.nom.size();
+    std::uint64_t h = Individu::hacher(ind.sexe, nom, lg, ind.date);
+    std::uint32_t f = (std::uint32_t)(h >> 58); // 6 bits de poids fort : NB_FRAGMENTS = 64
+    Fragment & frag = fragments[f];
+
+    std::lock_guard<std::mutex> verrou(frag.verrou);
+    std::uint32_t rang = (std::uint32_t)frag.fiches.size(); // rang de l'individu s'il est nouveau
+    std::uint32_t res = frag.index.inserer(h, rang, [&](std::uint32_t r) {
+        const Fiche & fi = frag.fiches[r];
+        return fi.date == ind.date and fi.sexe == ind.sexe and fi.nomLg == lg
+               and std::memcmp(frag.car.data()+fi.nomDebut, nom, lg) == 0;
+    });
+    if (res != rang)
+        return frag.fiches[res].id; // doublon : l'identifiant du premier
+
+    PersonId id = prochain.fetch_add(1);
+    assert(id != TableIds::VIDE);
+    frag.fiches.push_back(Fiche{ind.sexe, ind.date, (std::uint32_t)frag.car.size(), lg, id});
+    frag.car.insert(frag.car.end(), nom, nom+lg);
+    Case & c = caseDe(id);
+    c.fragment = f;
+    c.rang = rang;
+    return id;
+}
+
+//--------------------------------------------------------------------
+void Ingestion::setPere(PersonId id, PersonId pere)
+{
+    caseDe(id).pere.store((std::int32_t)pere, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------------
+void Ingestion::setMere(PersonId id, PersonId mere)
+{
+    caseDe(id).mere.store((std::int32_t)mere, std::memory_order_relaxed);
+}
+
+//--------------------------------------------------------------------
+std::size_t Ingestion::taille() const
+{
+    return prochain.load();
+}
+
+//--------------------------------------------------------------------
+Ancetres Ingestion::terminer()
+{
+    // les nœuds sont rangés par identifiant : celui que chaque producteur a reçu reste valable
+    PersonId n = prochain.load();
+    Ancetres anc;
+    anc.noeuds.reserve(n);
+    anc.indTOnd.reserver(n);
+    for (PersonId id = 0; id < n; ++id) {
+        Case & c = caseDe(id);
+        const Fragment & frag = fragments[c.fragment];
+        const Fiche & fi = frag.fiches[c.rang];
+        anc.noeuds.push_back(Ancetres::Noeud{fi.sexe, anc.interner(frag.car.data()+fi.nomDebut, fi.nomLg), fi.date,
+                                             c.pere.load(std::memory_order_relaxed), c.mere.load(std::memory_order_relaxed)});
+        anc.indexer(id);
+    }
+    anc.recompterEnfants();
+
+    // remise à vide
+    for (unsigned int f = 0; f < NB_FRAGMENTS; ++f) {
+        fragments[f].index = TableIds();
+        std::vector<Fiche>().swap(fragments[f].fiches);
+        std::vector<char>().swap(fragments[f].car);
+    }
+    for (std::size_t b = 0; b < NB_BLOCS; ++b)
+        delete[] blocs[b].exchange(nullptr);
+    prochain.store(0);
+    return anc;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file ingestion.hpp
+ * @date 18/10/2026 Création
+ * @brief Définition de la classe Ingestion
+**/
+
+#ifndef _INGESTION_HPP_
+#define _INGESTION_HPP_
+
+#include <vector> // pour le type std::vector
+#include <memory> // pour le type std::unique_ptr
+#include <mutex> // pour le type std::mutex
+#include <atomic> // pour le type std::atomic
+#include <cstdint> // pour les types std::uint32_t et std::int32_t
+#include "ancetres.hpp" // pour les types Ancetres et PersonId
+#include "individu.hpp" // pour le type Individu
+#include "tableids.hpp" // pour le type TableIds
+
+/**
+ * @brief La classe Ingestion construit une forêt d'ancêtres à partir de plusieurs fils producteurs à la fois
+ *
+ * l'index des individus est réparti en fragments, chacun sous son propre verrou : deux producteurs ne
+ * s'attendent que s'ils ajoutent des individus du même fragment. Un individu reçoit son identifiant d'un
+ * compteur atomique, sous le verrou de son fragment, si bien qu'un doublon est toujours reconnu et reçoit
+ * l'identifiant du premier. Les liens sont écrits sans verrou, chacun dans la case de son individu.
+ * Une fois les producteurs terminés, terminer assemble la forêt, en gardant les identifiants attribués
+**/
+class Ingestion
+{
+    public:
+        /**
+         * @brief Constructeur d'une ingestion vide
+         *
+         * @b Complexité -temporelle : Θ(nbFragments + nbBlocs)
+         *							 -spatiale : Θ(nbFragments + nbBlocs)
+         **/
+        Ingestion();
+
+        /// Une ingestion n'est pas copiable : ses producteurs la partagent
+        Ingestion(const Ingestion &) = delete;
+        /// Une ingestion n'est pas copiable : ses producteurs la partagent
+        Ingestion & operator=(const Ingestion &) = delete;
+
+        /**
+         * @brief Destructeur
+         *
+         * @b Complexité Θ(nbBlocs)
+         **/
+        ~Ingestion();
+
+        /**
+         * @brief Ajoute un individu, depuis n'importe quel fil
+         * @param ind L'individu à ajouter
+         * @return Son identifiant, celui qu'il avait déjà s'il a été ajouté auparavant
+         *
+         * @b Complexité -temporelle : Θ(|nom|) en moyenne amortie, plus l'attente du verrou d'un fragment
+         *							 -spatiale : O(|nom|) amortie
+         **/
+        PersonId ajouter(const Individu & ind);
+
+        /**
+         * @brief Modifie le père d'un individu, depuis n'importe quel fil
+         * @param id L'identifiant de l'individu
+         * @param pere L'identifiant de son père
+         * @pre id et pere ont été rendus par ajouter
+         *
+         * @b Complexité Θ(1), sans verrou
+         **/
+        void setPere(PersonId id, PersonId pere);
+
+        /**
+         * @brief Modifie la mère d'un individu, depuis n'importe quel fil
+         * @param id L'identifiant de l'individu
+         * @param mere L'identifiant de sa mère
+         * @pre id et mere ont été rendus par ajouter
+         *
+         * @b Complexité Θ(1), sans verrou
+         **/
+        void setMere(PersonId id, PersonId mere);
+
+        /**
+         * @brief Donne le nombre d'individus ajoutés
+         * @return Le nombre d'identifiants attribués
+         *
+         * @b Complexité Θ(1)
+         **/
+        std::size_t taille() const;
+
+        /**
+         * @brief Assemble la forêt des individus et des liens ajoutés
+         * @pre Aucun producteur n'est plus en cours
+         * @return La forêt, où chaque individu a l'identifiant que lui a rendu ajouter
+         * @post L'ingestion est vide
+         *
+         * @b Complexité -temporelle : Θ(N) en moyenne, avec N le nombre d'individus ajoutés
+         *							 -spatiale : Θ(N)
+         **/
+        Ancetres terminer();
+
+    private:
+        // nombre de fragments de l'index (puissance de 2), choisi par les bits de poids fort du hachage
+        static const unsigned int NB_FRAGMENTS = 64;
+        // nombre de cases d'un bloc de liens (puissance de 2), et de blocs pour couvrir tous les identifiants
+        static const unsigned int BITS_BLOC = 16;
+        static const std::size_t NB_BLOCS = (std::size_t)1 << (32-BITS_BLOC);
+        // Un individu rangé dans un fragment, son nom étant dans les caractères du fragment
+        struct Fiche {
+            char sexe; // le sexe de l'individu
+            std::uint32_t date; // sa date de naissance codée
+            std::uint32_t nomDebut, nomLg; // son nom dans les caractères du fragment
+            PersonId id; // l'identifiant attribué
+        };
+        // Un fragment de l'index et ses individus, sous un même verrou
+        struct Fragment {
+            std::mutex verrou;
+            TableIds index; // table associative individu->rang dans fiches
+            std::vector<Fiche> fiches;
+            std::vector<char> car;
+        };
+        // La case d'un identifiant : où trouver sa fiche, et ses liens (-1 si inconnus)
+        struct Case {
+            std::uint32_t fragment, rang; // écrits sous le verrou du fragment
+            std::atomic<std::int32_t> pere, mere;
+        };
+        // Attributs
+        std::unique_ptr<Fragment[]> fragments; // les fragments de l'index
+        std::unique_ptr<std::atomic<Case*>[]> blocs; // les blocs de cases, créés au premier identifiant de chacun
+        std::atomic<PersonId> prochain; // le prochain identifiant à attribuer
+        // Méthodes
+
+        /**
+         * @brief Accède à la case d'un identifiant, en créant son bloc au besoin
+         * @param id L'identifiant
+         * @return La case
+         *
+         * @b Complexité Θ(1), plus Θ(taille d'un bloc) à la création d'un bloc
+         **/
+        Case & caseDe(PersonId id);
+};
+
+#endif // _INGESTION_HPP_
@@ -0,0 +1,175 @@
+/**
+ * @file intersection.cpp
+ * @date 18/10/2026 Création
+ * @brief Définition des fonctions d'intersection de suites triées d'identifiants
+**/
+#include "intersection.hpp" // pour les fonctions intersecter
+#include <algorithm> // pour std::lower_bound et std::min
+
+// SSE2 fait partie du jeu d'instructions de base en x86-64 ; AVX2 n'est employé qu'après
+// vérification du processeur, le noyau étant compilé à part pour cette cible
+#if defined(__SSE2__)
+#define INTERSECTION_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INTERSECTION_AVX2
+#include <immintrin.h>
+#endif
+
+//--------------------------------------------------------------------
+// fusion scalaire de a[i..na[ et b[j..nb[, les positions trouvées étant écrites à partir de pos[n]
+static std::size_t fusionner(const std::uint32_t * a, std::size_t i, std::size_t na,
+                             const std::uint32_t * b, std::size_t j, std::size_t nb,
+                             std::uint32_t * pos, std::size_t n)
+{
+    while (i < na and j < nb) {
+        if (a[i] < b[j])
+            ++i;
+        else if (b[j] < a[i])
+            ++j;
+        else {
+            pos[n++] = (std::uint32_t)i;
+            ++i;
+            ++j;
+        }
+    }
+    return n;
+}
+
+//--------------------------------------------------------------------
+// première position p >= deb de t telle que t[p] >= v, n s'il n'y en a pas
+// le pas double jusqu'à dépasser v, puis la recherche se termine par dichotomie
+static std::size_t galoper(const std::uint32_t * t, std::size_t deb, std::size_t n, std::uint32_t v)
+{
+    std::size_t pas = 1, haut = deb;
+    while (haut < n and t[haut] < v) {
+        deb = haut+1;
+        haut += pas;
+        pas *= 2;
+    }
+    return (std::size_t)(std::lower_bound(t+deb, t+std::min(haut,n), v) - t);
+}
+
+#ifdef INTERSECTION_SSE2
+//--------------------------------------------------------------------
+// compare les blocs de 4 de a et de b tant qu'il en reste ; i et j s'arrêtent sur les restes
+static std::size_t blocsSSE2(const std::uint32_t * a, std::size_t & i, std::size_t na,
+                             const std::uint32_t * b, std::size_t & j, std::size_t nb,
+                             std::uint32_t * pos, std::size_t n)
+{
+    while (i+4 <= na and j+4 <= nb) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a+i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b+j));
+        // chaque élément de va est comparé aux 4 rotations de vb
+        __m128i egal = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb), _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0,3,2,1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1,0,3,2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2,1,0,3)))));
+        int masque = _mm_movemask_ps(_mm_castsi128_ps(egal));
+        for (std::size_t k = 0; masque != 0; ++k, masque >>= 1)
+            if (masque & 1)
+                pos[n++] = (std::uint32_t)(i+k);
+        // le bloc dont le dernier élément est le plus petit ne peut plus rien rencontrer
+        std::uint32_t derA = a[i+3], derB = b[j+3];
+        if (derA <= derB)
+            i += 4;
+        if (derB <= derA)
+            j += 4;
+    }
+    return n;
+}
+#endif
+
+#ifdef INTERSECTION_AVX2
+//--------------------------------------------------------------------
+// même principe que blocsSSE2 sur des blocs de 8
+__attribute__((target("avx2")))
+static std::size_t blocsAVX2(const std::uint32_t * a, std::size_t & i, std::size_t na,
+                             const std::uint32_t * b, std::size_t & j, std::size_t nb,
+                             std::uint32_t * pos, std::size_t n)
+{
+    const __m256i rotation = _mm256_setr_epi32(1,2,3,4,5,6,7,0);
+    while (i+8 <= na and j+8 <= nb) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a+i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b+j));
+        __m256i egal = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; ++r) {
+            vb = _mm256_permutevar8x32_epi32(vb, rotation);
+            egal = _mm256_or_si256(egal, _mm256_cmpeq_epi32(va, vb));
+        }
+        int masque = _mm256_movemask_ps(_mm256_castsi256_ps(egal));
+        for (std::size_t k = 0; masque != 0; ++k, masque >>= 1)
+            if (masque & 1)
+                pos[n++] = (std::uint32_t)(i+k);
+        std::uint32_t derA = a[i+7], derB = b[j+7];
+        if (derA <= derB)
+            i += 8;
+        if (derB <= derA)
+            j += 8;
+    }
+    return n;
+}
+
+// vrai ssi le processeur exécute les instructions AVX2, vérifié une seule fois
+static bool avx2Disponible()
+{
+    static const bool dispo = __builtin_cpu_supports("avx2") != 0;
+    return dispo;
+}
+#endif
+
+//--------------------------------------------------------------------
+std::size_t intersecterScalaire(const std::uint32_t * a, std::size_t na, const std::uint32_t * b, std::size_t nb, std::uint32_t * pos)
+{
+    return fusionner(a, 0, na, b, 0, nb, pos, 0);
+}
+
+//--------------------------------------------------------------------
+std::size_t intersecterGalop(const std::uint32_t * a, std::size_t na, const std::uint32_t * b, std::size_t nb, std::uint32_t * pos)
+{
+    std::size_t n = 0;
+    if (na <= nb) {
+        std::size_t j = 0;
+        for (std::size_t i = 0; i < na; ++i) {
+            j = galoper(b, j, nb, a[i]);
+            if (j == nb)
+                break;
+            if (b[j] == a[i])
+                pos[n++] = (std::uint32_t)i;
+        }
+    } else {
+        std::size_t i = 0;
+        for (std::size_t j = 0; j < nb; ++j) {
+            i = galoper(a, i, na, b[j]);
+            if (i == na)
+                break;
+            if (a[i] == b[j])
+                pos[n++] = (std::uint32_t)i;
+        }
+    }
+    return n;
+}
+
+//--------------------------------------------------------------------
+std::size_t intersecterVectoriel(const std::uint32_t * a, std::size_t na, const std::uint32_t * b, std::size_t nb, std::uint32_t * pos)
+{
+    std::size_t i = 0, j = 0, n = 0;
+#ifdef INTERSECTION_AVX2
+    if (avx2Disponible())
+        n = blocsAVX2(a, i, na, b, j, nb, pos, n);
+#endif
+#ifdef INTERSECTION_SSE2
+    n = blocsSSE2(a, i, na, b, j, nb, pos, n);
+#endif
+    return fusionner(a, i, na, b, j, nb, pos, n);
+}
+
+//--------------------------------------------------------------------
+std::size_t intersecter(const std::uint32_t * a, std::size_t na, const std::uint32_t * b, std::size_t nb, std::uint32_t * pos)
+{
+    // au-delà d'un rapport de 32 entre les tailles, sauter dans la longue suite coûte moins que la parcourir
+    if (na > 32*nb or nb > 32*na)
+        return intersecterGalop(a, na, b, nb, pos);
+    return intersecterVectoriel(a, na, b, nb, pos);
+}
@@ -0,0 +1,58 @@
+/**
+ * @file intersection.hpp
+ * @date 18/10/2026 Création
+ * @brief Déclaration des fonctions d'intersection de suites triées d'identifiants
+**/
+
+#ifndef _INTERSECTION_HPP_
+#define _INTERSECTION_HPP_
+
+#include <cstdint> // pour le type std::uint32_t
+#include <cstddef> // pour le type std::size_t
+
+/**
+ * @brief Calcule l'intersection de deux suites strictement croissantes d'identifiants
+ * @param a La première suite
+ * @param na Le nombre d'éléments de a
+ * @param b La seconde suite
+ * @param nb Le nombre d'éléments de b
+ * @param pos Le tableau résultat, d'au moins min(na,nb) cases
+ * @return Le nombre d'éléments communs ; pos reçoit, par ordre croissant, leurs positions dans a
+ *
+ * choisit le noyau selon les tailles et la machine : galop si l'une des suites est bien plus courte
+ * que l'autre, sinon comparaison par blocs AVX2 ou SSE2 si le processeur les offre, fusion scalaire à défaut
+ *
+ * @b Complexité -temporelle : O(min(na,nb)*log(max(na,nb)/min(na,nb))) pour des tailles très inégales, O(na+nb) sinon
+ *							 -spatiale : O(1)
+ **/
+std::size_t intersecter(const std::uint32_t * a, std::size_t na, const std::uint32_t * b, std::size_t nb, std::uint32_t * pos);
+
+/**
+ * @brief Intersection par fusion des deux suites, un élément à la fois (mêmes paramètres que intersecter)
+ *
+ * @b Complexité -temporelle : O(na+nb)
+ *							 -spatiale : O(1)
+ **/
+std::size_t intersecterScalaire(const std::uint32_t * a, std::size_t na, const std::uint32_t * b, std::size_t nb, std::uint32_t * pos);
+
+/**
+ * @brief Intersection par recherche exponentielle de chaque élément de la plus courte suite dans l'autre
+ * (mêmes paramètres que intersecter)
+ *
+ * @b Complexité -temporelle : O(min(na,nb)*log(max(na,nb)/min(na,nb)))
+ *							 -spatiale : O(1)
+ **/
+std::size_t intersecterGalop(const std::uint32_t * a, std::size_t na, const std::uint32_t * b, std::size_t nb, std::uint32_t * pos);
+
+/**
+ * @brief Intersection par comparaison de blocs de 4 (SSE2) ou 8 (AVX2) éléments de chaque suite
+ * (mêmes paramètres que intersecter)
+ *
+ * se replie sur intersecterScalaire quand le processeur, ou la compilation, n'offre pas ces instructions
+ *
+ * @b Complexité -temporelle : O(na+nb)
+ *							 -spatiale : O(1)
+ **/
+std::size_t intersecterVectoriel(const std::uint32_t * a, std::size_t na, const std::uint32_t * b, std::size_t nb, std::uint32_t * pos);
+
+#endif // _INTERSECTION_HPP_
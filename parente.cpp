@@ -0,0 +1,298 @@
+/**
+ * @file parente.cpp
+ * @date 18/10/2026 Création
+ * @brief Définition des méthodes de la classe Parente
+**/
+#include "parente.hpp" // pour le type Parente
+#include <algorithm> // pour std::sort, std::push_heap, std::pop_heap, std::min et std::max
+#include <thread> // pour le type std::thread
+#include <utility> // pour std::swap
+
+//--------------------------------------------------------------------
+Parente::Parente(const Ancetres & foret)
+: anc(foret)
+{
+    anc.figer(); // générations et enfants calculés d'avance : la forêt se lit de plusieurs fils sans rien modifier
+}
+
+//--------------------------------------------------------------------
+PersonId Parente::pere(PersonId a) const
+{
+    PersonId p = anc.getPere(a); // TableIds::VIDE (-1) si inconnu
+    return p != TableIds::VIDE and anc.generation(p) < anc.generation(a) ? p : TableIds::VIDE;
+}
+
+//--------------------------------------------------------------------
+PersonId Parente::mere(PersonId a) const
+{
+    PersonId m = anc.getMere(a);
+    return m != TableIds::VIDE and anc.generation(m) < anc.generation(a) ? m : TableIds::VIDE;
+}
+
+//--------------------------------------------------------------------
+std::uint64_t Parente::hacher(PersonId a, PersonId b)
+{
+    return TableIds::melanger((std::uint64_t)std::min(a,b)<<32 | std::max(a,b));
+}
+
+//--------------------------------------------------------------------
+bool Parente::enCache(PersonId a, PersonId b, double & phi) const
+{
+    PersonId bas = std::min(a,b), haut = std::max(a,b);
+    std::uint32_t r = index.trouver(hacher(a,b), [&](std::uint32_t i) {
+        return paires[i].a == bas and paires[i].b == haut;
+    });
+    if (r == TableIds::VIDE)
+        return false;
+    phi = paires[r].phi;
+    return true;
+}
+
+//--------------------------------------------------------------------
+void Parente::ranger(PersonId a, PersonId b, double phi)
+{
+    PersonId bas = std::min(a,b), haut = std::max(a,b);
+    std::uint32_t r = (std::uint32_t)paires.size(); // rang de la paire si elle est nouvelle
+    if (index.inserer(hacher(a,b), r, [&](std::uint32_t i) { return paires[i].a == bas and paires[i].b == haut; }) == r)
+        paires.push_back(Paire{bas, haut, phi});
+}
+
+//--------------------------------------------------------------------
+double Parente::parente(PersonId a, PersonId b)
+{
+    double phi;
+    if (enCache(a,b,phi))
+        return phi;
+    // une paire n'est calculée que lorsque les paires dont elle dépend sont en cache :
+    // sinon elles sont empilées au-dessus d'elle, et elle sera reprise après elles
+    pile.clear();
+    pile.push_back(std::make_pair(a,b));
+    while (!pile.empty()) {
+        PersonId x = pile.back().first, y = pile.back().second;
+        if (enCache(x,y,phi)) {
+            pile.pop_back(); // empilée deux fois, déjà calculée
+            continue;
+        }
+        std::size_t attente = pile.size();
+        if (x == y) {
+            // φ(x,x) = (1 + F(x))/2, avec F(x) = φ(père, mère)
+            PersonId p = pere(x), m = mere(x);
+            double f = 0;
+            if (!toutesF.empty())
+                f = toutesF[x];
+            else if (p != TableIds::VIDE and m != TableIds::VIDE and !enCache(p,m,f))
+                pile.push_back(std::make_pair(p,m));
+            if (pile.size() != attente)
+                continue;
+            phi = (1+f)/2;
+        } else {
+            // x devient le plus jeune des deux : de génération supérieure, il n'est pas ancêtre de y
+            std::uint32_t gx = anc.generation(x), gy = anc.generation(y);
+            if (gy > gx or (gy == gx and y > x))
+                std::swap(x,y);
+            PersonId p = pere(x), m = mere(x);
+            double fp = 0, fm = 0;
+            if (p != TableIds::VIDE and !enCache(p,y,fp))
+                pile.push_back(std::make_pair(p,y));
+            if (m != TableIds::VIDE and !enCache(m,y,fm))
+                pile.push_back(std::make_pair(m,y));
+            if (pile.size() != attente)
+                continue;
+            phi = (fp+fm)/2;
+        }
+        ranger(x,y,phi);
+        pile.pop_back();
+    }
+    enCache(a,b,phi);
+    return phi;
+}
+
+//--------------------------------------------------------------------
+double Parente::consanguinite(PersonId a)
+{
+    if (!toutesF.empty())
+        return toutesF[a];
+    PersonId p = pere(a), m = mere(a);
+    return p == TableIds::VIDE or m == TableIds::VIDE ? 0 : parente(p,m);
+}
+
+//--------------------------------------------------------------------
+const std::vector<double> & Parente::consanguinites()
+{
+    std::size_t n = anc.taille();
+    if (!toutesF.empty() or n == 0)
+        return toutesF;
+    // ordre de traitement : par génération croissante, donc chaque parent avant ses enfants,
+    // et les enfants de mêmes parents à la suite, qui partagent leur coefficient
+    std::vector<PersonId> ordre(n);
+    std::vector<PersonId> peres(n), meres(n);
+    for (PersonId a = 0; a < n; ++a) {
+        ordre[a] = a;
+        peres[a] = pere(a);
+        meres[a] = mere(a);
+    }
+    std::sort(ordre.begin(), ordre.end(), [&](PersonId a, PersonId b) {
+        std::uint32_t ga = anc.generation(a), gb = anc.generation(b);
+        if (ga != gb)
+            return ga < gb;
+        if (peres[a] != peres[b])
+            return peres[a] < peres[b];
+        if (meres[a] != meres[b])
+            return meres[a] < meres[b];
+        return a < b;
+    });
+    std::vector<std::uint32_t> rang(n);
+    for (std::uint32_t i = 0; i < n; ++i)
+        rang[ordre[i]] = i;
+    // tout est ensuite indexé par rang : les parents d'un rang sont à des rangs plus petits
+    std::vector<std::uint32_t> rp(n), rm(n);
+    for (std::uint32_t i = 0; i < n; ++i) {
+        PersonId p = peres[ordre[i]], m = meres[ordre[i]];
+        rp[i] = p == TableIds::VIDE ? TableIds::VIDE : rang[p];
+        rm[i] = m == TableIds::VIDE ? TableIds::VIDE : rang[m];
+    }
+    std::vector<PersonId>().swap(peres);
+    std::vector<PersonId>().swap(meres);
+
+    // Meuwissen et Luo : F(a) = somme sur les ancêtres j de a (a compris) de L(a,j)² * D(j) - 1,
+    // où L(a,j) est la part des gènes de a venue de j par toutes les lignées, et D(j) la part propre à j
+    std::vector<double> F(n, 0), D(n, 0), L(n, 0);
+    std::vector<std::uint32_t> tas; // rangs des ancêtres en attente, le plus récent d'abord
+    for (std::uint32_t i = 0; i < n; ++i) {
+        std::uint32_t p = rp[i], m = rm[i];
+        if (i > 0 and p != TableIds::VIDE and m != TableIds::VIDE and p == rp[i-1] and m == rm[i-1]) {
+            F[i] = F[i-1]; // même père et même mère : même coefficient
+            D[i] = D[i-1];
+            continue;
+        }
+        if (p != TableIds::VIDE and m != TableIds::VIDE)
+            D[i] = 0.5 - 0.25*(F[p]+F[m]);
+        else if (p != TableIds::VIDE or m != TableIds::VIDE)
+            D[i] = 0.75 - 0.25*F[p != TableIds::VIDE ? p : m];
+        else
+            D[i] = 1;
+        // propagation de i vers ses ancêtres, du plus récent au plus ancien : quand un ancêtre sort du tas,
+        // tous ses descendants par lesquels passent les lignées de i en sont déjà sortis
+        double somme = 0;
+        L[i] = 1;
+        tas.push_back(i);
+        while (!tas.empty()) {
+            std::pop_heap(tas.begin(), tas.end());
+            std::uint32_t j = tas.back();
+            tas.pop_back();
+            somme += L[j]*L[j]*D[j];
+            for (std::uint32_t k : {rp[j], rm[j]})
+                if (k != TableIds::VIDE) {
+                    if (L[k] == 0) {
+                        tas.push_back(k);
+                        std::push_heap(tas.begin(), tas.end());
+                    }
+                    L[k] += 0.5*L[j];
+                }
+            L[j] = 0;
+        }
+        F[i] = std::max(0.0, somme-1); // l'arrondi peut donner -1e-16 à un non consanguin
+    }
+    // retour à l'ordre des identifiants
+    toutesF.resize(n);
+    for (std::uint32_t i = 0; i < n; ++i)
+        toutesF[ordre[i]] = F[i];
+    return toutesF;
+}
+
+//--------------------------------------------------------------------
+std::vector<double> Parente::matrice(const std::vector<PersonId> & ids, unsigned int nbTaches)
+{
+    std::size_t n = ids.size();
+    std::vector<double> res(n*n);
+    if (n == 0)
+        return res;
+    const std::vector<double> & F = consanguinites();
+
+    // méthode indirecte de Colleau : 2φ = T D Tᵗ, où T donne les parts de gènes transmises des ancêtres
+    // aux descendants ; une colonne de la matrice se calcule en remontant vers les ancêtres puis en redescendant,
+    // sur les seuls ancêtres des individus demandés, rangés des plus anciens aux plus récents
+    std::vector<std::uint32_t> local(anc.taille(), TableIds::VIDE);
+    std::vector<PersonId> membres;
+    for (PersonId a : ids)
+        if (local[a] == TableIds::VIDE) {
+            local[a] = 0;
+            membres.push_back(a);
+        }
+    for (std::size_t k = 0; k < membres.size(); ++k) // parcours en largeur des ancêtres
+        for (PersonId q : {pere(membres[k]), mere(membres[k])})
+            if (q != TableIds::VIDE and local[q] == TableIds::VIDE) {
+                local[q] = 0;
+                membres.push_back(q);
+            }
+    std::sort(membres.begin(), membres.end(), [&](PersonId a, PersonId b) {
+        std::uint32_t ga = anc.generation(a), gb = anc.generation(b);
+        return ga != gb ? ga < gb : a < b;
+    });
+    std::size_t m = membres.size();
+    for (std::uint32_t k = 0; k < m; ++k)
+        local[membres[k]] = k;
+    std::vector<std::uint32_t> lp(m), lm(m); // parents en rang local
+    std::vector<double> D(m); // part propre à chaque membre, comme dans consanguinites
+    for (std::uint32_t k = 0; k < m; ++k) {
+        PersonId p = pere(membres[k]), q = mere(membres[k]);
+        lp[k] = p == TableIds::VIDE ? TableIds::VIDE : local[p];
+        lm[k] = q == TableIds::VIDE ? TableIds::VIDE : local[q];
+        if (p != TableIds::VIDE and q != TableIds::VIDE)
+            D[k] = 0.5 - 0.25*(F[p]+F[q]);
+        else if (p != TableIds::VIDE or q != TableIds::VIDE)
+            D[k] = 0.75 - 0.25*F[p != TableIds::VIDE ? p : q];
+        else
+            D[k] = 1;
+    }
+
+    if (nbTaches == 0)
+        nbTaches = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t nbFils = std::max<std::size_t>(1, std::min<std::size_t>(nbTaches, n));
+    // colonnes distribuées tour à tour entre les fils, chacun avec ses propres vecteurs de travail
+    auto boucle = [&](std::size_t debut) {
+        std::vector<double> x(m), y(m);
+        for (std::size_t c = debut; c < n; c += nbFils) {
+            std::uint32_t cible = local[ids[c]];
+            std::fill(x.begin(), x.begin() + cible + 1, 0.0);
+            x[cible] = 1;
+            for (std::uint32_t k = cible + 1; k-- > 0; ) // remontée : les enfants avant les parents
+                if (x[k] != 0) {
+                    if (lp[k] != TableIds::VIDE)
+                        x[lp[k]] += 0.5*x[k];
+                    if (lm[k] != TableIds::VIDE)
+                        x[lm[k]] += 0.5*x[k];
+                }
+            for (std::uint32_t k = 0; k < m; ++k) { // descente : les parents avant les enfants
+                double v = k <= cible ? D[k]*x[k] : 0;
+                if (lp[k] != TableIds::VIDE)
+                    v += 0.5*y[lp[k]];
+                if (lm[k] != TableIds::VIDE)
+                    v += 0.5*y[lm[k]];
+                y[k] = v;
+            }
+            for (std::size_t i = 0; i < n; ++i)
+                res[i*n+c] = y[local[ids[i]]]/2;
+        }
+    };
+    std::vector<std::thread> fils;
+    for (std::size_t t = 1; t < nbFils; ++t)
+        fils.emplace_back(boucle, t);
+    boucle(0);
+    for (std::thread & t : fils)
+        t.join();
+    return res;
+}
+
+//--------------------------------------------------------------------
+std::size_t Parente::tailleCache() const
+{
+    return paires.size();
+}
+
+//--------------------------------------------------------------------
+void Parente::viderCache()
+{
+    index = TableIds();
+    std::vector<Paire>().swap(paires);
+}
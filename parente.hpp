@@ -0,0 +1,178 @@
+/**
+ * @file parente.hpp
+ * @date 18/10/2026 Création
+ * @brief Définition de la classe Parente
+**/
+
+#ifndef _PARENTE_HPP_
+#define _PARENTE_HPP_
+
+#include <vector> // pour le type std::vector
+#include <cstdint> // pour le type std::uint32_t
+#include "ancetres.hpp" // pour le type Ancetres
+#include "tableids.hpp" // pour le type TableIds
+
+/**
+ * @brief La classe Parente calcule coefficients de parenté et de consanguinité dans une forêt d'ancêtres
+ *
+ * le coefficient de parenté φ(a,b) est la probabilité que deux gènes tirés au hasard, l'un chez a, l'autre chez b,
+ * soient identiques par descendance ; le coefficient de consanguinité F(a) est la parenté de ses parents.
+ * Tous deux tiennent compte de l'implexe : un ancêtre atteint par plusieurs lignées compte pour chacune.
+ *
+ * φ se calcule par la récurrence  φ(a,a) = (1 + F(a))/2  et, si a n'est pas ancêtre de b,
+ * φ(a,b) = (φ(père(a),b) + φ(mère(a),b))/2, un parent inconnu comptant pour 0 : on développe toujours
+ * le plus jeune des deux, celui de plus grande génération (voir Ancetres::generation). Chaque paire calculée
+ * est gardée dans un cache creux, où les requêtes suivantes la retrouvent ; la pile de calcul est explicite,
+ * si bien que la profondeur des lignées ne menace pas la pile d'exécution.
+ *
+ * un lien qui ne fait pas descendre la génération (lien d'un cycle, ignoré par Ancetres::generation) est ignoré.
+ * La forêt ne doit pas être modifiée tant que le moteur s'en sert
+**/
+class Parente
+{
+    public:
+        /**
+         * @brief Constructeur d'un moteur sur une forêt
+         * @param anc La forêt, qui doit survivre au moteur sans être modifiée
+         * @post La forêt est figée (voir Ancetres::figer) : plusieurs moteurs peuvent s'en servir à la fois
+         *
+         * @b Complexité -temporelle : Θ(N) si la forêt n'était pas figée, Θ(1) sinon
+         *							 -spatiale : O(N)
+         **/
+        explicit Parente(const Ancetres & anc);
+
+        /**
+         * @brief Calcule le coefficient de parenté de deux individus
+         * @param a Le premier individu
+         * @param b Le second individu
+         * @pre a < anc.taille() et b < anc.taille()
+         * @return φ(a,b), entre 0 et 1 ; φ(a,a) = (1 + F(a))/2
+         *
+         * @b Complexité -temporelle : O(1) si la paire est en cache, sinon O(nombre de paires d'ancêtres de a et de b
+         *												 qui ne sont pas encore en cache)
+         *							 -spatiale : O(idem)
+         **/
+        double parente(PersonId a, PersonId b);
+
+        /**
+         * @brief Calcule le coefficient de consanguinité d'un individu
+         * @param a L'individu
+         * @pre a < anc.taille()
+         * @return F(a) = φ(père(a), mère(a)), 0 si l'un des parents est inconnu
+         *
+         * @b Complexité celle de parente(père(a), mère(a)), Θ(1) après consanguinites
+         **/
+        double consanguinite(PersonId a);
+
+        /**
+         * @brief Calcule les coefficients de consanguinité de tous les individus de la forêt en un passage
+         * @return F de chaque individu, par identifiant ; la référence reste valide autant que le moteur
+         *
+         * méthode de Meuwissen et Luo : les individus sont traités des plus anciens aux plus récents,
+         * les frères et sœurs de mêmes parents à la suite ; pour chacun, la contribution de ses ancêtres
+         * est propagée de génération en génération, ce qui ne coûte que le nombre de ses ancêtres.
+         * Le résultat est calculé une fois, puis resservi, et sert aussi à parente pour φ(a,a)
+         *
+         * @b Complexité -temporelle : O(somme sur les individus du nombre de leurs ancêtres * log) au premier appel, Θ(1) ensuite
+         *							 -spatiale : Θ(N)
+         **/
+        const std::vector<double> & consanguinites();
+
+        /**
+         * @brief Calcule la matrice de parenté d'une liste d'individus, répartie sur plusieurs fils
+         * @param ids Les individus
+         * @param nbTaches Le nombre de fils d'exécution (0 = autant que de cœurs)
+         * @pre Chaque identifiant est < anc.taille()
+         * @return La matrice symétrique des φ(ids[i],ids[j]), rangée ligne par ligne (n*n valeurs)
+         *
+         * méthode indirecte de Colleau, à partir des coefficients de consanguinité (calculés s'il le faut) :
+         * chaque colonne coûte un aller-retour sur les ancêtres des individus demandés, sans passer par
+         * le cache des paires ; les colonnes sont réparties entre les fils
+         *
+         * @b Complexité -temporelle : O(N + A log A + n * (A + n) / nbTaches), A le nombre d'ancêtres des ids,
+         *												 plus consanguinites au premier appel
+         *							 -spatiale : Θ(n² + N)
+         **/
+        std::vector<double> matrice(const std::vector<PersonId> & ids, unsigned int nbTaches = 0);
+
+        /**
+         * @brief Donne le nombre de paires gardées dans le cache
+         * @return Le nombre de paires
+         *
+         * @b Complexité Θ(1)
+         **/
+        std::size_t tailleCache() const;
+
+        /**
+         * @brief Vide le cache des paires, pour rendre sa mémoire
+         * @post Les coefficients de consanguinité déjà calculés par consanguinites sont conservés
+         *
+         * @b Complexité Θ(nombre de paires)
+         **/
+        void viderCache();
+
+    private:
+        // Une paire calculée : les deux individus, le plus petit identifiant d'abord, et leur parenté
+        struct Paire {
+            PersonId a, b;
+            double phi;
+        };
+        // Attributs
+        const Ancetres & anc; // la forêt
+        TableIds index; // table associative paire->rang dans paires, hachée sur les deux identifiants
+        std::vector<Paire> paires; // les paires calculées
+        std::vector<double> toutesF; // F de chaque individu, vide tant que consanguinites n'a pas été appelée
+        std::vector<std::pair<PersonId,PersonId>> pile; // paires en attente de calcul, réutilisée d'un appel à l'autre
+        // Méthodes
+
+        /**
+         * @brief Donne le père d'un individu s'il fait descendre la génération
+         * @param a L'individu
+         * @return Le père, TableIds::VIDE s'il est inconnu ou si le lien est ignoré
+         *
+         * @b Complexité Θ(1)
+         **/
+        PersonId pere(PersonId a) const;
+
+        /**
+         * @brief Donne la mère d'un individu si elle fait descendre la génération
+         * @param a L'individu
+         * @return La mère, TableIds::VIDE si elle est inconnue ou si le lien est ignoré
+         *
+         * @b Complexité Θ(1)
+         **/
+        PersonId mere(PersonId a) const;
+
+        /**
+         * @brief Recherche une paire dans le cache
+         * @param a Le premier individu
+         * @param b Le second individu
+         * @param phi Reçoit φ(a,b) si la paire est en cache
+         * @return Vrai ssi la paire est en cache
+         *
+         * @b Complexité Θ(1) en moyenne
+         **/
+        bool enCache(PersonId a, PersonId b, double & phi) const;
+
+        /**
+         * @brief Range une paire dans le cache
+         * @param a Le premier individu
+         * @param b Le second individu
+         * @param phi φ(a,b)
+         *
+         * @b Complexité Θ(1) en moyenne amortie
+         **/
+        void ranger(PersonId a, PersonId b, double phi);
+
+        /**
+         * @brief Hache une paire, dans un ordre indifférent
+         * @param a Le premier individu
+         * @param b Le second individu
+         * @return Le hachage utilisé dans index
+         *
+         * @b Complexité Θ(1)
+         **/
+        static std::uint64_t hacher(PersonId a, PersonId b);
+};
+
+#endif // _PARENTE_HPP_
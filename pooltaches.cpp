@@ -0,0 +1,125 @@
+/**
+ * @file pooltaches.cpp
+ * @date 18/10/2026 Création
+ * @brief Définition des méthodes de la classe PoolTaches
+**/
+#include "pooltaches.hpp" // pour le type PoolTaches
+#include <algorithm> // pour std::max
+#include <utility> // pour std::move
+
+// le pool et l'indice du fil courant, pour ranger dans sa propre file les tâches soumises par une tâche
+static thread_local const PoolTaches * poolDuFil = nullptr;
+static thread_local unsigned int indiceDuFil = 0;
+
+//--------------------------------------------------------------------
+PoolTaches::PoolTaches(unsigned int nbFils)
+: prochaineFile(0),
+  enAttente(0),
+  enCours(0),
+  dormeurs(0),
+  arret(false)
+{
+    if (nbFils == 0)
+        nbFils = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned int i = 0; i < nbFils; ++i)
+        files.emplace_back(new File);
+    for (unsigned int i = 0; i < nbFils; ++i)
+        fils.emplace_back(&PoolTaches::boucle, this, i);
+}
+
+//--------------------------------------------------------------------
+PoolTaches::~PoolTaches()
+{
+    attendre();
+    {
+        std::lock_guard<std::mutex> verrou(etat);
+        arret = true;
+    }
+    travail.notify_all();
+    for (std::thread & t : fils)
+        t.join();
+}
+
+//--------------------------------------------------------------------
+unsigned int PoolTaches::nbFils() const
+{
+    return (unsigned int)fils.size();
+}
+
+//--------------------------------------------------------------------
+void PoolTaches::soumettre(std::function<void()> tache)
+{
+    unsigned int i = poolDuFil == this ? indiceDuFil : prochaineFile++ % (unsigned int)files.size();
+    // en cours avant d'être visible : attendre ne peut pas voir enCours revenir à 0 entre-temps
+    ++enCours;
+    {
+        std::lock_guard<std::mutex> verrou(files[i]->verrou);
+        files[i]->taches.push_back(std::move(tache));
+    }
+    // en attente une fois rangée : un fil réveillé la trouve. Soit ce compte est vu par un fil qui s'endort,
+    // soit son endormissement est vu ici (ordre séquentiel des deux atomiques), et il est réveillé
+    ++enAttente;
+    if (dormeurs.load() > 0) {
+        std::lock_guard<std::mutex> verrou(etat);
+        travail.notify_one();
+    }
+}
+
+//--------------------------------------------------------------------
+void PoolTaches::attendre()
+{
+    std::unique_lock<std::mutex> verrou(etat);
+    fini.wait(verrou, [this]() { return enCours == 0; });
+}
+
+//--------------------------------------------------------------------
+bool PoolTaches::prendre(unsigned int i, std::function<void()> & tache)
+{
+    {
+        File & f = *files[i];
+        std::lock_guard<std::mutex> verrou(f.verrou);
+        if (!f.taches.empty()) {
+            tache = std::move(f.taches.back());
+            f.taches.pop_back();
+            return true;
+        }
+    }
+    // vol, en commençant par le fil voisin pour répartir les voleurs
+    for (std::size_t k = 1; k < files.size(); ++k) {
+        File & f = *files[(i+k) % files.size()];
+        std::lock_guard<std::mutex> verrou(f.verrou);
+        if (!f.taches.empty()) {
+            tache = std::move(f.taches.front());
+            f.taches.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+//--------------------------------------------------------------------
+void PoolTaches::boucle(unsigned int i)
+{
+    poolDuFil = this;
+    indiceDuFil = i;
+    std::function<void()> tache;
+    for (;;) {
+        if (prendre(i, tache)) {
+            --enAttente; // peut passer un instant sous 0, si la tâche est prise avant d'être comptée
+            tache();
+            tache = nullptr;
+            if (--enCours == 0) {
+                std::lock_guard<std::mutex> verrou(etat);
+                fini.notify_all();
+            }
+            continue;
+        }
+        // rien à prendre : sommeil jusqu'à la prochaine soumission
+        std::unique_lock<std::mutex> verrou(etat);
+        ++dormeurs;
+        travail.wait(verrou, [this]() { return arret or enAttente.load() > 0; });
+        --dormeurs;
+        if (arret and enAttente.load() <= 0)
+            return;
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * @file pooltaches.hpp
+ * @date 18/10/2026 Création
+ * @brief Définition de la classe PoolTaches
+**/
+
+#ifndef _POOLTACHES_HPP_
+#define _POOLTACHES_HPP_
+
+#include <vector> // pour le type std::vector
+#include <deque> // pour le type std::deque
+#include <memory> // pour le type std::unique_ptr
+#include <functional> // pour le type std::function
+#include <thread> // pour le type std::thread
+#include <mutex> // pour le type std::mutex
+#include <condition_variable> // pour le type std::condition_variable
+#include <atomic> // pour le type std::atomic
+
+/**
+ * @brief La classe PoolTaches exécute des tâches sur un ensemble fixe de fils, avec vol de travail
+ *
+ * chaque fil a sa propre file : il y prend ses tâches par la fin (la plus récente, encore en cache) et,
+ * quand elle est vide, en vole une au début de la file d'un autre fil. Les tâches soumises de l'extérieur
+ * sont distribuées tour à tour entre les files ; celles soumises par une tâche vont dans la file de son fil
+**/
+class PoolTaches
+{
+    public:
+        /**
+         * @brief Constructeur, qui lance les fils
+         * @param nbFils Le nombre de fils, 0 pour autant que de cœurs
+         *
+         * @b Complexité Θ(nbFils)
+         **/
+        explicit PoolTaches(unsigned int nbFils = 0);
+
+        /// Un pool n'est pas copiable : ses fils le désignent
+        PoolTaches(const PoolTaches &) = delete;
+        /// Un pool n'est pas copiable : ses fils le désignent
+        PoolTaches & operator=(const PoolTaches &) = delete;
+
+        /**
+         * @brief Destructeur, qui termine les tâches restantes puis arrête les fils
+         *
+         * @b Complexité Θ(nbFils), plus l'exécution des tâches restantes
+         **/
+        ~PoolTaches();
+
+        /**
+         * @brief Soumet une tâche, depuis n'importe quel fil
+         * @param tache La tâche à exécuter
+         *
+         * @b Complexité Θ(1) amortie
+         **/
+        void soumettre(std::function<void()> tache);
+
+        /**
+         * @brief Attend que toutes les tâches soumises soient terminées
+         * @pre L'appelant n'est pas une tâche du pool
+         *
+         * @b Complexité Θ(1), plus l'attente
+         **/
+        void attendre();
+
+        /**
+         * @brief Donne le nombre de fils du pool
+         * @return Le nombre de fils
+         *
+         * @b Complexité Θ(1)
+         **/
+        unsigned int nbFils() const;
+
+    private:
+        // La file de tâches d'un fil, sous son propre verrou
+        struct File {
+            std::mutex verrou;
+            std::deque<std::function<void()>> taches;
+        };
+        // Attributs
+        std::vector<std::unique_ptr<File>> files; // une file par fil
+        std::vector<std::thread> fils; // les fils d'exécution
+        std::atomic<unsigned int> prochaineFile; // file qui reçoit la prochaine tâche soumise de l'extérieur
+        // les compteurs sont atomiques : soumettre, prendre et terminer une tâche ne passent que par le verrou de sa file ;
+        // etat ne sert qu'à endormir et réveiller les fils, et attendre
+        std::mutex etat; // garde arret, et l'attente sur travail et fini
+        std::condition_variable travail; // signalé quand une tâche est soumise alors qu'un fil dort, ou le pool arrêté
+        std::condition_variable fini; // signalé quand la dernière tâche en cours se termine
+        std::atomic<long> enAttente; // nombre de tâches rangées dans les files et pas encore prises
+        std::atomic<long> enCours; // nombre de tâches soumises et non terminées
+        std::atomic<int> dormeurs; // nombre de fils endormis ou sur le point de l'être
+        bool arret; // vrai quand le pool s'arrête
+        // Méthodes
+
+        /**
+         * @brief Prend une tâche pour un fil : la plus récente de sa file, sinon la plus ancienne d'une autre
+         * @param i Le fil
+         * @param tache La tâche prise
+         * @return Vrai ssi une tâche a été prise
+         *
+         * @b Complexité O(nbFils)
+         **/
+        bool prendre(unsigned int i, std::function<void()> & tache);
+
+        /**
+         * @brief Boucle d'un fil : exécute des tâches tant qu'il y en a, dort sinon, jusqu'à l'arrêt du pool
+         * @param i Le fil
+         **/
+        void boucle(unsigned int i);
+};
+
+#endif // _POOLTACHES_HPP_
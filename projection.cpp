@@ -0,0 +1,86 @@
+/**
+ * @file projection.cpp
+ * @date 18/10/2026 Création
+ * @brief Définition des méthodes de la classe Projection
+**/
+
+#include "projection.hpp" // pour le type Projection
+#include <fstream> // pour le type std::ifstream
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h> // pour mmap et munmap
+#include <sys/stat.h> // pour fstat
+#include <fcntl.h> // pour open
+#include <unistd.h> // pour close
+#define PROJECTION_MMAP
+#endif
+
+//--------------------------------------------------------------------
+Projection::Projection(const std::string & fic)
+: debut(nullptr), lg(0), projetee(false), ok(false)
+{
+#ifdef PROJECTION_MMAP
+    int fd = open(fic.c_str(), O_RDONLY);
+    if (fd != -1)
+    {
+        struct stat st;
+        if (fstat(fd,&st) == 0)
+        {
+            ok = true;
+            lg = (std::size_t)st.st_size;
+            if (lg > 0)
+            {
+                void * p = mmap(nullptr, lg, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED)
+                {
+                    // lecture séquentielle : on demande au noyau de lire en avance
+                    madvise(p, lg, MADV_SEQUENTIAL);
+                    debut = static_cast<const char *>(p);
+                    projetee = true;
+                }
+                else
+                    ok = false;
+            }
+        }
+        close(fd);
+        if (ok)
+            return;
+    }
+#endif
+    // repli : lecture du fichier d'un seul bloc
+    std::ifstream f(fic, std::ios::binary | std::ios::ate);
+    if (!f.is_open())
+        return;
+    ok = true;
+    tampon.resize((std::size_t)f.tellg());
+    f.seekg(0);
+    f.read(tampon.data(), (std::streamsize)tampon.size());
+    lg = tampon.size();
+    debut = lg > 0 ? tampon.data() : nullptr;
+}
+
+//--------------------------------------------------------------------
+Projection::~Projection()
+{
+#ifdef PROJECTION_MMAP
+    if (projetee)
+        munmap(const_cast<char *>(debut), lg);
+#endif
+}
+
+//--------------------------------------------------------------------
+bool Projection::ouverte() const
+{
+    return ok;
+}
+
+//--------------------------------------------------------------------
+const char * Projection::donnees() const
+{
+    return debut;
+}
+
+//--------------------------------------------------------------------
+std::size_t Projection::taille() const
+{
+    return lg;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file projection.hpp
+ * @date 18/10/2026 Création
+ * @brief Définition de la classe Projection
+**/
+
+#ifndef _PROJECTION_HPP_
+#define _PROJECTION_HPP_
+
+#include <string> // pour le type std::string
+#include <vector> // pour le type std::vector
+#include <cstddef> // pour le type std::size_t
+
+/**
+ * @brief La classe Projection donne accès en lecture seule au contenu d'un fichier projeté en mémoire
+ * 
+ * le fichier est projeté (mmap) là où c'est possible, sinon lu d'un bloc dans un tampon
+**/
+class Projection
+{
+    public:
+        /**
+         * @brief Constructeur à partir d'un fichier
+         * @param fic Le fichier à projeter
+         * @post ouverte() indique si la projection a réussi
+         * 
+         * @b Complexité -temporelle : O(1) si le fichier est projeté, Θ(N) s'il est lu, avec N = taille du fichier
+         *							 -spatiale : O(1) si le fichier est projeté, Θ(N) s'il est lu
+         **/
+        Projection(const std::string & fic);
+
+        /// Une projection n'est pas copiable
+        Projection(const Projection &) = delete;
+        /// Une projection n'est pas copiable
+        Projection & operator=(const Projection &) = delete;
+
+        /**
+         * @brief Destructeur, libère la projection
+         * 
+         * @b Complexité Θ(1)
+         **/
+        ~Projection();
+
+        /**
+         * @brief Indique si le fichier a pu être ouvert
+         * @return Vrai ssi le contenu du fichier est accessible
+         * 
+         * @b Complexité Θ(1)
+         **/
+        bool ouverte() const;
+
+        /**
+         * @brief Accède au contenu du fichier
+         * @return Le premier octet du fichier (nullptr s'il est vide)
+         * 
+         * @b Complexité Θ(1)
+         **/
+        const char * donnees() const;
+
+        /**
+         * @brief Donne la taille du fichier
+         * @return Le nombre d'octets accessibles depuis donnees()
+         * 
+         * @b Complexité Θ(1)
+         **/
+        std::size_t taille() const;
+
+    private:
+        // Attributs
+        const char * debut; // début du contenu
+        std::size_t lg; // taille du contenu
+        bool projetee; // vrai ssi debut provient de mmap
+        bool ok; // vrai ssi le fichier a été ouvert
+        std::vector<char> tampon; // contenu lu, quand la projection est impossible
+};
+
+#endif // _PROJECTION_HPP_
@@ -0,0 +1,170 @@
+/**
+ * @file requetes.cpp
+ * @date 18/10/2026 Création
+ * @brief Programme d'exécution par lot de requêtes sur un registre
+ *
+ * usage : requetes.exe registre [fichier de requêtes] [nombre de fils]
+ *
+ * le registre est un fichier texte (voir Ancetres::Ancetres) ou un instantané binaire (voir Ancetres::sauvegarder) ;
+ * les requêtes sont lues dans le fichier, ou sur l'entrée standard s'il est absent ou vaut "-", une par ligne,
+ * les individus étant désignés par leur numéro dans le registre (à partir de 1) :
+ *   communs n1 n2          les ancêtres communs de n1 et n2
+ *   ppac n1 n2             leurs plus proches ancêtres communs, avec la distance à chacun
+ *   ancetres n g           les ancêtres de n sur g générations, chacun une fois
+ *   sosa n g               leur liste de Sosa, un implexe sous chacun de ses numéros
+ *   degre n k              les descendants de n au degré k
+ *   racines                les individus sans enfant
+ *   present sexe nom date  1 si l'individu est dans le registre, 0 sinon
+ * les lignes vides et celles commençant par # sont ignorées.
+ *
+ * les requêtes s'exécutent en parallèle (voir PoolTaches) ; les résultats sont écrits dans l'ordre des requêtes,
+ * chacun dès qu'il est prêt et que tous les précédents l'ont été, précédé d'une ligne "> numéro requête"
+**/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include "ancetres.hpp"
+#include "descendants.hpp"
+#include "pooltaches.hpp"
+using namespace std;
+
+// lit le numéro d'un individu du registre et le convertit en identifiant, faux s'il n'en désigne aucun
+static bool lireIndividu(istringstream & is, const Ancetres & anc, PersonId & id)
+{
+    unsigned long n;
+    if (!(is >> n) or n == 0 or n > anc.taille())
+        return false;
+    id = anc.identifiantOrigine((PersonId)(n-1)); // le registre peut être un instantané renuméroté
+    return true;
+}
+
+// exécute une requête et rend son résultat, une ligne par élément
+static string executer(const string & requete, const Ancetres & anc)
+{
+    istringstream is(requete);
+    ostringstream os;
+    string type;
+    is >> type;
+    PersonId id1, id2;
+    if (type == "communs") {
+        if (!lireIndividu(is,anc,id1) or !lireIndividu(is,anc,id2))
+            return "! numéro d'individu invalide\n";
+        Ancetres com = anc.ancetresCommuns(id1,id2);
+        com.pourChaqueIndividu([&os,&com](const VueIndividu & v) { os << com.individu(v.id) << '\n'; });
+    } else if (type == "ppac") {
+        if (!lireIndividu(is,anc,id1) or !lireIndividu(is,anc,id2))
+            return "! numéro d'individu invalide\n";
+        for (const AncetreCommun & ac : anc.plusProchesAncetresCommuns(id1,id2))
+            os << anc.individu(ac.ancetre) << '\t' << ac.d1 << '\t' << ac.d2 << '\n';
+    } else if (type == "ancetres" or type == "sosa") {
+        unsigned int g;
+        if (!lireIndividu(is,anc,id1) or !(is >> g))
+            return "! numéro d'individu ou nombre de générations invalide\n";
+        if (type == "sosa")
+            anc.afficherSosa(os, id1, g);
+        else {
+            Ancetres asc = anc.ancetres(id1, g);
+            asc.pourChaqueIndividu([&os,&asc](const VueIndividu & v) { os << asc.individu(v.id) << '\n'; });
+        }
+    } else if (type == "degre") {
+        unsigned int k;
+        if (!lireIndividu(is,anc,id1) or !(is >> k))
+            return "! numéro d'individu ou degré invalide\n";
+        Descendants des(id1,anc);
+        des.pourChaqueAuDegre(k, [&os,&anc](const VueIndividu & v) { os << anc.individu(v.id) << '\n'; });
+    } else if (type == "racines") {
+        anc.pourChaqueRacine([&os,&anc](const VueIndividu & v) { os << anc.individu(v.id) << '\n'; });
+    } else if (type == "present") {
+        string sexe, nom, date;
+        if (!(is >> sexe >> nom >> date) or sexe.size() != 1 or date.size() != 10)
+            return "! individu invalide (sexe nom AAAA-MM-JJ)\n";
+        try {
+            os << anc.estPresent(sexe[0], nom.data(), nom.size(), date.data()) << '\n';
+        } catch (const invalid_argument &) {
+            return "! individu invalide (sexe nom AAAA-MM-JJ)\n";
+        }
+    } else
+        return "! requête inconnue : " + type + "\n";
+    return os.str();
+}
+
+/// Programme principal : charge le registre, exécute les requêtes en parallèle et écrit les résultats dans l'ordre
+int main(int argc, char * argv[])
+{
+    if (argc < 2) {
+        cerr << "usage : " << argv[0] << " registre [fichier de requêtes] [nombre de fils]" << endl;
+        return 1;
+    }
+    ios::sync_with_stdio(false);
+    unsigned int nbFils = argc > 3 ? (unsigned int)atoi(argv[3]) : 0;
+
+    // chargement, puis calcul d'avance de tout ce qui est calculé à la demande : la forêt est lue par tous les fils
+    string registre = argv[1];
+    Ancetres anc;
+    if (registre.size() > 4 and registre.compare(registre.size()-4, 4, ".bin") == 0) {
+        if (!anc.charger(registre)) {
+            cerr << "instantané illisible : " << registre << endl;
+            return 1;
+        }
+    } else {
+        try {
+            anc = Ancetres(registre, nbFils);
+        } catch (const exception & e) {
+            cerr << "registre mal formé : " << registre << " : " << e.what() << endl;
+            return 1;
+        }
+    }
+    anc.figer();
+
+    // lecture des requêtes
+    ifstream fic;
+    if (argc > 2 and string(argv[2]) != "-") {
+        fic.open(argv[2]);
+        if (!fic) {
+            cerr << "fichier de requêtes illisible : " << argv[2] << endl;
+            return 1;
+        }
+    }
+    istream & entree = fic.is_open() ? fic : cin;
+    vector<string> requetes;
+    for (string ligne; getline(entree, ligne); )
+        if (!ligne.empty() and ligne[0] != '#')
+            requetes.push_back(ligne);
+
+    // exécution : chaque résultat est rangé à la place de sa requête, puis signalé
+    vector<string> resultats(requetes.size());
+    unique_ptr<bool[]> prets(new bool[requetes.size()]());
+    mutex verrou;
+    condition_variable pret;
+    PoolTaches pool(nbFils);
+    for (size_t i = 0; i < requetes.size(); ++i)
+        pool.soumettre([&,i]() {
+            string res = executer(requetes[i], anc);
+            lock_guard<mutex> v(verrou);
+            resultats[i].swap(res);
+            prets[i] = true;
+            pret.notify_all();
+        });
+
+    // écriture dans l'ordre des requêtes, chaque résultat libéré dès qu'il est écrit
+    for (size_t i = 0; i < requetes.size(); ++i) {
+        string res;
+        {
+            unique_lock<mutex> v(verrou);
+            pret.wait(v, [&]() { return prets[i]; });
+            res.swap(resultats[i]);
+        }
+        cout << "> " << i+1 << ' ' << requetes[i] << '\n' << res;
+    }
+    cout.flush();
+    return 0;
+}
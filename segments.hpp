@@ -0,0 +1,554 @@
+/**
+ * @file segments.hpp
+ * @date 18/10/2026 Création
+ * @brief Définition de la classe Segments
+**/
+
+#ifndef _SEGMENTS_HPP_
+#define _SEGMENTS_HPP_
+
+#include <atomic> // pour le type std::atomic
+#include <cstddef> // pour les types std::size_t et std::ptrdiff_t
+#include <cstring> // pour std::memcpy
+#include <iterator> // pour le type std::forward_iterator_tag
+#include <new> // pour ::operator new et le placement new
+#include <type_traits> // pour std::is_trivially_copyable
+#include <algorithm> // pour std::min et std::max
+
+/**
+ * @brief La classe Segments est un tableau découpé en segments de 2^BITS éléments, partagés entre ses copies
+ *
+ * une copie ne recopie que la table des segments et compte une référence de plus sur chacun ; un segment
+ * n'est dupliqué qu'à la première écriture d'un tableau qui le partage (copie sur écriture). Deux copies
+ * ne diffèrent donc que des segments modifiés depuis la copie : copier une forêt, pour en publier une
+ * version (voir ForetPartagee), coûte le nombre de ses segments et non de ses éléments
+ *
+ * les éléments d'un même segment sont contigus. Le premier segment grandit par doublement jusqu'à 2^BITS
+ * éléments, de sorte qu'un petit tableau n'en occupe pas un entier ; les suivants sont alloués pleins.
+ * Les éléments sont recopiés octet par octet et ne sont jamais détruits
+ *
+ * les méthodes const ne modifient rien, pas même les compteurs : un tableau se lit depuis plusieurs fils à la
+ * fois, pendant qu'un autre fil modifie une de ses copies
+**/
+template<class T, unsigned int BITS = 10>
+class Segments
+{
+    static_assert(std::is_trivially_copyable<T>::value, "Segments ne range que des éléments recopiables octet par octet");
+
+    public:
+        /// Nombre d'éléments d'un segment plein
+        static const std::size_t TAILLE = std::size_t(1) << BITS;
+
+        /// Itérateur de lecture sur les éléments, dans l'ordre des indices
+        class const_iterator
+        {
+            public:
+                typedef std::forward_iterator_tag iterator_category;
+                typedef T value_type;
+                typedef std::ptrdiff_t difference_type;
+                typedef const T * pointer;
+                typedef const T & reference;
+                /// Itérateur sur l'élément i de s
+                const_iterator(const Segments * tableau, std::size_t indice) : s(tableau), i(indice) {}
+                /// L'élément courant
+                const T & operator*() const { return (*s)[i]; }
+                /// Accès à un membre de l'élément courant
+                const T * operator->() const { return &(*s)[i]; }
+                /// Passage à l'élément suivant
+                const_iterator & operator++() { ++i; return *this; }
+                /// Passage à l'élément suivant, en rendant l'itérateur d'avant
+                const_iterator operator++(int) { const_iterator it(*this); ++i; return it; }
+                /// Vrai ssi les itérateurs désignent le même élément
+                bool operator==(const const_iterator & it) const { return i == it.i; }
+                /// Vrai ssi les itérateurs désignent des éléments différents
+                bool operator!=(const const_iterator & it) const { return i != it.i; }
+            private:
+                const Segments * s;
+                std::size_t i;
+        };
+
+        /**
+         * @brief Constructeur d'un tableau vide
+         *
+         * @b Complexité Θ(1)
+         **/
+        Segments();
+
+        /**
+         * @brief Constructeur par copie, qui partage les segments de s
+         * @param s Le tableau à copier
+         *
+         * @b Complexité -temporelle : Θ(nombre de segments)
+         *							 -spatiale : Θ(nombre de segments)
+         **/
+        Segments(const Segments & s);
+
+        /**
+         * @brief Constructeur par déplacement, qui laisse s vide
+         * @param s Le tableau à déplacer
+         *
+         * @b Complexité Θ(1)
+         **/
+        Segments(Segments && s) noexcept;
+
+        /**
+         * @brief Affectation par copie, qui partage les segments de s
+         * @param s Le tableau à copier
+         * @return L'instance
+         *
+         * @b Complexité -temporelle : Θ(nombre de segments des deux tableaux)
+         *							 -spatiale : Θ(nombre de segments de s)
+         **/
+        Segments & operator=(const Segments & s);
+
+        /**
+         * @brief Affectation par déplacement, qui laisse s vide
+         * @param s Le tableau à déplacer
+         * @return L'instance
+         *
+         * @b Complexité -temporelle : Θ(nombre de segments de l'instance)
+         *							 -spatiale : O(1)
+         **/
+        Segments & operator=(Segments && s) noexcept;
+
+        /**
+         * @brief Destructeur, qui libère les segments dont l'instance était la dernière à se servir
+         *
+         * @b Complexité Θ(nombre de segments)
+         **/
+        ~Segments();
+
+        /// Le nombre d'éléments
+        std::size_t size() const { return nb; }
+
+        /// Vrai ssi le tableau est vide
+        bool empty() const { return nb == 0; }
+
+        /**
+         * @brief Lit un élément
+         * @param i Son indice
+         * @pre i < size()
+         * @return L'élément, valide jusqu'à la prochaine modification du tableau
+         *
+         * @b Complexité Θ(1)
+         **/
+        const T & operator[](std::size_t i) const { return elements(table[i >> BITS])[i & (TAILLE-1)]; }
+
+        /**
+         * @brief Accède en écriture à un élément, après avoir dupliqué son segment s'il est partagé
+         * @param i Son indice
+         * @pre i < size()
+         * @return L'élément, valide jusqu'au prochain ajout
+         *
+         * @b Complexité -temporelle : Θ(1), plus Θ(2^BITS) à la première écriture dans un segment partagé
+         *							 -spatiale : O(2^BITS)
+         **/
+        T & operator[](std::size_t i) { return ecrire(i >> BITS)[i & (TAILLE-1)]; }
+
+        /// Lit le dernier élément (@pre !empty())
+        const T & back() const { return (*this)[nb-1]; }
+
+        /// Accède en écriture au dernier élément (@pre !empty())
+        T & back() { return (*this)[nb-1]; }
+
+        /// Début du parcours
+        const_iterator begin() const { return const_iterator(this, 0); }
+
+        /// Fin du parcours
+        const_iterator end() const { return const_iterator(this, nb); }
+
+        /**
+         * @brief Ajoute un élément à la fin
+         * @param x L'élément
+         *
+         * @b Complexité -temporelle : Θ(1) amortie, plus Θ(2^BITS) si le dernier segment est partagé
+         *							 -spatiale : O(1) amortie
+         **/
+        void push_back(const T & x);
+
+        /**
+         * @brief Ajoute des éléments à la fin
+         * @param p Le premier élément
+         * @param n Le nombre d'éléments
+         *
+         * @b Complexité -temporelle : Θ(n) amortie, plus Θ(2^BITS) si le dernier segment est partagé
+         *							 -spatiale : Θ(n) amortie
+         **/
+        void ajouter(const T * p, std::size_t n);
+
+        /**
+         * @brief Retire le dernier élément
+         * @pre !empty()
+         *
+         * @b Complexité Θ(1)
+         **/
+        void pop_back();
+
+        /**
+         * @brief Change le nombre d'éléments
+         * @param n Le nouveau nombre d'éléments
+         * @param x La valeur des éléments ajoutés
+         *
+         * @b Complexité -temporelle : O(n + nombre de segments)
+         *							 -spatiale : O(n)
+         **/
+        void resize(std::size_t n, const T & x = T());
+
+        /**
+         * @brief Remplace le contenu par n copies d'un élément
+         * @param n Le nombre d'éléments
+         * @param x L'élément
+         *
+         * @b Complexité -temporelle : Θ(n + nombre de segments)
+         *							 -spatiale : Θ(n)
+         **/
+        void assign(std::size_t n, const T & x);
+
+        /**
+         * @brief Remplace le contenu par une suite d'éléments
+         * @param deb Le début de la suite
+         * @param fin La fin de la suite
+         *
+         * @b Complexité -temporelle : Θ(longueur de la suite + nombre de segments)
+         *							 -spatiale : Θ(longueur de la suite)
+         **/
+        template<class It>
+        void assign(It deb, It fin);
+
+        /**
+         * @brief Vide le tableau
+         *
+         * @b Complexité Θ(nombre de segments)
+         **/
+        void clear();
+
+        /**
+         * @brief Prépare la table des segments à recevoir n éléments
+         * @param n Le nombre d'éléments attendus
+         *
+         * @b Complexité -temporelle : O(n / 2^BITS)
+         *							 -spatiale : O(n / 2^BITS)
+         **/
+        void reserve(std::size_t n);
+
+        /// Le nombre de segments
+        std::size_t nbSegments() const { return nbBlocs; }
+
+        /// Les éléments contigus du segment k (@pre k < nbSegments())
+        const T * segment(std::size_t k) const { return elements(table[k]); }
+
+        /// Le nombre d'éléments du segment k (@pre k < nbSegments())
+        std::size_t tailleSegment(std::size_t k) const { return k+1 < nbBlocs ? TAILLE : nb - (k << BITS); }
+
+    private:
+        // Un segment : son compte de références et sa capacité, suivis de ses éléments
+        struct Bloc
+        {
+            std::atomic<long> refs; // nombre de tableaux qui se servent du segment
+            std::size_t capacite; // nombre d'éléments que peut recevoir le segment
+            explicit Bloc(std::size_t cap) : refs(1), capacite(cap) {}
+        };
+        // Décalage des éléments après l'en-tête d'un segment
+        static const std::size_t ENTETE = (sizeof(Bloc) + alignof(T)-1) & ~(alignof(T)-1);
+        // Capacité initiale du premier segment
+        static const std::size_t CAPACITE_MIN = TAILLE < 16 ? TAILLE : 16;
+        // Attributs
+        Bloc * seul; // l'unique entrée de la table tant qu'elle n'en a qu'une, sans allocation
+        Bloc ** table; // les segments, dans l'ordre : &seul, ou un tableau alloué de capTable entrées
+        std::size_t nbBlocs; // le nombre de segments
+        std::size_t capTable; // le nombre d'entrées de la table
+        std::size_t nb; // le nombre d'éléments
+        // Méthodes
+
+        /// Les éléments d'un segment
+        static T * elements(Bloc * b) { return reinterpret_cast<T *>(reinterpret_cast<char *>(b) + ENTETE); }
+
+        /// Alloue un segment d'une capacité donnée, utilisé par le seul appelant
+        static Bloc * creer(std::size_t cap);
+
+        /// Renonce à un segment, libéré par le dernier tableau qui s'en servait
+        static void lacher(Bloc * b);
+
+        /// Remplace le segment k par une copie de ses éléments dans un segment de capacité cap
+        T * dupliquer(std::size_t k, std::size_t cap);
+
+        /// Donne les éléments du segment k, dupliqué d'abord s'il est partagé
+        T * ecrire(std::size_t k);
+
+        /// Donne les éléments du segment k, créé ou agrandi pour recevoir besoin éléments, à soi seul
+        T * prevoir(std::size_t k, std::size_t besoin);
+
+        /// Agrandit la table pour recevoir n segments
+        void reserverTable(std::size_t n);
+
+        /// Libère les segments et la table
+        void liberer();
+
+        /// Reprend la table de s, qui devient vide
+        void reprendre(Segments & s);
+};
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+const std::size_t Segments<T,BITS>::TAILLE;
+
+template<class T, unsigned int BITS>
+const std::size_t Segments<T,BITS>::ENTETE;
+
+template<class T, unsigned int BITS>
+const std::size_t Segments<T,BITS>::CAPACITE_MIN;
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+Segments<T,BITS>::Segments()
+: seul(nullptr), table(&seul), nbBlocs(0), capTable(1), nb(0)
+{}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+Segments<T,BITS>::Segments(const Segments & s)
+: Segments()
+{
+    reserverTable(s.nbBlocs);
+    for (std::size_t k = 0; k < s.nbBlocs; ++k) {
+        s.table[k]->refs.fetch_add(1, std::memory_order_relaxed);
+        table[k] = s.table[k];
+    }
+    nbBlocs = s.nbBlocs;
+    nb = s.nb;
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+Segments<T,BITS>::Segments(Segments && s) noexcept
+: Segments()
+{
+    reprendre(s);
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+Segments<T,BITS> & Segments<T,BITS>::operator=(const Segments & s)
+{
+    if (this != &s) {
+        Segments copie(s);
+        liberer();
+        reprendre(copie);
+    }
+    return *this;
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+Segments<T,BITS> & Segments<T,BITS>::operator=(Segments && s) noexcept
+{
+    if (this != &s) {
+        liberer();
+        reprendre(s);
+    }
+    return *this;
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+Segments<T,BITS>::~Segments()
+{
+    liberer();
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::push_back(const T & x)
+{
+    std::size_t j = nb & (TAILLE-1);
+    T * e = prevoir(nb >> BITS, j+1);
+    new (e+j) T(x);
+    ++nb;
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::ajouter(const T * p, std::size_t n)
+{
+    // segment par segment, chacun rempli d'une seule recopie
+    while (n > 0) {
+        std::size_t j = nb & (TAILLE-1), lg = std::min(n, TAILLE-j);
+        T * e = prevoir(nb >> BITS, j+lg);
+        std::memcpy(static_cast<void *>(e+j), p, lg*sizeof(T));
+        nb += lg;
+        p += lg;
+        n -= lg;
+    }
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::pop_back()
+{
+    --nb;
+    if ((nb & (TAILLE-1)) == 0)
+        lacher(table[--nbBlocs]);
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::resize(std::size_t n, const T & x)
+{
+    if (n <= nb) {
+        // seuls les segments entièrement retirés sont rendus
+        std::size_t garde = (n + TAILLE-1) >> BITS;
+        while (nbBlocs > garde)
+            lacher(table[--nbBlocs]);
+        nb = n;
+        return;
+    }
+    reserverTable((n + TAILLE-1) >> BITS);
+    while (nb < n) {
+        std::size_t j = nb & (TAILLE-1), lg = std::min(n-nb, TAILLE-j);
+        T * e = prevoir(nb >> BITS, j+lg);
+        for (std::size_t k = j; k < j+lg; ++k)
+            new (e+k) T(x);
+        nb += lg;
+    }
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::assign(std::size_t n, const T & x)
+{
+    clear();
+    resize(n, x);
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+template<class It>
+void Segments<T,BITS>::assign(It deb, It fin)
+{
+    clear();
+    for ( ; deb != fin; ++deb)
+        push_back(*deb);
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::clear()
+{
+    while (nbBlocs > 0)
+        lacher(table[--nbBlocs]);
+    nb = 0;
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::reserve(std::size_t n)
+{
+    reserverTable((n + TAILLE-1) >> BITS);
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+typename Segments<T,BITS>::Bloc * Segments<T,BITS>::creer(std::size_t cap)
+{
+    return new (::operator new(ENTETE + cap*sizeof(T))) Bloc(cap);
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::lacher(Bloc * b)
+{
+    // le dernier à renoncer voit toutes les écritures des autres avant de libérer
+    if (b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        b->~Bloc();
+        ::operator delete(b);
+    }
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+T * Segments<T,BITS>::dupliquer(std::size_t k, std::size_t cap)
+{
+    Bloc * b = table[k], * c = creer(cap);
+    std::memcpy(static_cast<void *>(elements(c)), elements(b), std::min(tailleSegment(k), cap)*sizeof(T));
+    table[k] = c;
+    lacher(b);
+    return elements(c);
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+T * Segments<T,BITS>::ecrire(std::size_t k)
+{
+    // seul détenteur du segment, le tableau peut l'écrire : les anciens détenteurs y ont renoncé (acquisition)
+    Bloc * b = table[k];
+    if (b->refs.load(std::memory_order_acquire) != 1)
+        return dupliquer(k, b->capacite);
+    return elements(b);
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+T * Segments<T,BITS>::prevoir(std::size_t k, std::size_t besoin)
+{
+    if (k == nbBlocs) {
+        reserverTable(k+1);
+        table[k] = creer(k == 0 ? std::max(besoin, CAPACITE_MIN) : TAILLE);
+        ++nbBlocs;
+        return elements(table[k]);
+    }
+    std::size_t cap = table[k]->capacite;
+    if (besoin <= cap)
+        return ecrire(k);
+    while (cap < besoin)
+        cap *= 2;
+    return dupliquer(k, std::min(cap, TAILLE));
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::reserverTable(std::size_t n)
+{
+    if (n <= capTable)
+        return;
+    std::size_t cap = std::max(n, 2*capTable);
+    Bloc ** t = new Bloc*[cap];
+    for (std::size_t k = 0; k < nbBlocs; ++k)
+        t[k] = table[k];
+    if (table != &seul)
+        delete[] table;
+    table = t;
+    capTable = cap;
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::liberer()
+{
+    clear();
+    if (table != &seul)
+        delete[] table;
+    seul = nullptr;
+    table = &seul;
+    capTable = 1;
+}
+
+//--------------------------------------------------------------------
+template<class T, unsigned int BITS>
+void Segments<T,BITS>::reprendre(Segments & s)
+{
+    if (s.table == &s.seul) {
+        seul = s.seul;
+        table = &seul;
+    } else
+        table = s.table;
+    nbBlocs = s.nbBlocs;
+    capTable = s.capTable;
+    nb = s.nb;
+    s.seul = nullptr;
+    s.table = &s.seul;
+    s.nbBlocs = 0;
+    s.capTable = 1;
+    s.nb = 0;
+}
+
+#endif // _SEGMENTS_HPP_
@@ -0,0 +1,98 @@
+/**
+ * @file tableids.cpp
+ * @date 18/10/2026 Création
+ * @brief Définition des méthodes de la classe TableIds
+**/
+
+#include "tableids.hpp" // pour le type TableIds
+#include <utility> // pour std::move
+
+const std::uint32_t TableIds::VIDE;
+const std::size_t TableIds::GROUPE;
+const std::uint8_t TableIds::LIBRE;
+
+//--------------------------------------------------------------------
+TableIds::TableIds()
+: tab(), controle(), nb(0)
+{}
+
+//--------------------------------------------------------------------
+void TableIds::reserver(std::size_t n)
+{
+    while (n*4 > tab.size()*3)
+        agrandir();
+}
+
+//--------------------------------------------------------------------
+std::size_t TableIds::taille() const
+{
+    return nb;
+}
+
+//--------------------------------------------------------------------
+const Segments<TableIds::Case> & TableIds::cases() const
+{
+    return tab;
+}
+
+//--------------------------------------------------------------------
+void TableIds::restaurer(const Case * c, std::size_t nbCases, std::size_t n)
+{
+    tab.clear();
+    tab.ajouter(c, nbCases);
+    nb = n;
+    // les octets de contrôle ne sont pas sérialisés : ils se déduisent des empreintes
+    controle.assign(nbCases, LIBRE);
+    for (std::size_t i = 0; i < nbCases; ++i)
+        if (c[i].id != VIDE)
+            controle[i] = etiquette(c[i].empreinte);
+}
+
+//--------------------------------------------------------------------
+void TableIds::renumeroter(const std::uint32_t * vers)
+{
+    for (std::size_t i = 0; i < tab.size(); ++i)
+        if (tab[i].id != VIDE)
+            tab[i].id = vers[tab[i].id];
+}
+
+//--------------------------------------------------------------------
+void TableIds::agrandir()
+{
+    Segments<Case> anc(std::move(tab));
+    tab.assign(anc.empty() ? GROUPE : anc.size()*2, Case{VIDE,0});
+    controle.assign(tab.size(), LIBRE);
+    std::size_t masque = tab.size()-1;
+    for (const Case & c : anc)
+        if (c.id != VIDE)
+        {
+            std::size_t i = c.empreinte & masque;
+            while (tab[i].id != VIDE)
+                i = (i+1) & masque;
+            occuper(i, c.id, c.empreinte);
+        }
+}
+
+//--------------------------------------------------------------------
+std::uint64_t TableIds::melanger(std::uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+//--------------------------------------------------------------------
+std::uint64_t TableIds::hacher(const char * p, std::size_t lg)
+{
+    // FNV-1a sur 64 bits, puis mélange final pour répartir les bits de poids faible
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (std::size_t i = 0; i < lg; ++i)
+    {
+        h ^= (unsigned char)p[i];
+        h *= 0x100000001b3ull;
+    }
+    return melanger(h ^ lg);
+}
@@ -0,0 +1,299 @@
+/**
+ * @file tableids.hpp
+ * @date 18/10/2026 Création
+ * @brief Définition de la classe TableIds
+**/
+
+#ifndef _TABLEIDS_HPP_
+#define _TABLEIDS_HPP_
+
+#include <cstdint> // pour les types std::uint32_t et std::uint64_t
+#include <cstddef> // pour le type std::size_t
+#include "segments.hpp" // pour le type Segments
+#if defined(__SSE2__)
+#include <emmintrin.h> // pour la comparaison de 16 octets de contrôle à la fois
+#endif
+
+/**
+ * @brief La classe TableIds est une table de hachage à adressage ouvert (sondage linéaire) d'identifiants
+ * 
+ * la table ne range que des identifiants 32 bits et l'empreinte de leur clé : c'est l'appelant qui
+ * fournit le hachage et le test d'égalité sur ses propres données. Les cases forment un tableau segmenté
+ * (voir Segments), qui s'écrit et se relit tel quel (voir Ancetres::sauvegarder) ; deux copies d'une table
+ * partagent leurs segments jusqu'à ce que l'une les modifie
+ * 
+ * à la manière des SwissTable, un octet de contrôle par case (7 bits de l'empreinte, ou VIDE) est rangé
+ * à part : le sondage compare 16 octets de contrôle à la fois (SSE2) et ne lit que les cases dont
+ * l'octet correspond. Les groupes sont alignés sur 16 cases, donc contenus dans un seul segment ; dans
+ * le groupe de départ, les cases qui précèdent la case de départ sont ignorées et ne sont lues qu'au
+ * retour du sondage, de sorte que l'ordre de sondage reste celui du sondage linéaire case par case.
+ * Une recherche lit d'abord sa case de départ, où se trouvent la plupart des clés présentes
+**/
+class TableIds
+{
+    public:
+        /// Identifiant signalant une case vide ou une recherche infructueuse
+        static const std::uint32_t VIDE = 0xFFFFFFFFu;
+
+        /// Une case : l'identifiant rangé et les 32 bits de poids faible du hachage de sa clé
+        struct Case
+        {
+            std::uint32_t id; // VIDE si la case est libre
+            std::uint32_t empreinte; // hachage de la clé, qui donne aussi la case de départ
+        };
+
+        /**
+         * @brief Constructeur d'une table vide
+         * 
+         * @b Complexité Θ(1)
+         **/
+        TableIds();
+
+        /**
+         * @brief Prépare la table à recevoir n identifiants sans s'agrandir
+         * @param n Le nombre d'identifiants attendus
+         * 
+         * @b Complexité -temporelle : O(n + taille())
+         *							 -spatiale : O(n)
+         **/
+        void reserver(std::size_t n);
+
+        /**
+         * @brief Donne le nombre d'identifiants rangés
+         * @return Le nombre d'identifiants
+         * 
+         * @b Complexité Θ(1)
+         **/
+        std::size_t taille() const;
+
+        /**
+         * @brief Recherche l'identifiant d'une clé
+         * @param h Le hachage de la clé
+         * @param egal Prédicat indiquant si l'identifiant passé en paramètre a pour clé celle recherchée
+         * @return L'identifiant trouvé, VIDE sinon
+         * 
+         * @b Complexité -temporelle : Θ(1) en moyenne
+         *							 -spatiale : O(1)
+         **/
+        template<class Egal>
+        std::uint32_t trouver(std::uint64_t h, Egal egal) const;
+
+        /**
+         * @brief Range un identifiant si sa clé n'est pas déjà présente
+         * @param h Le hachage de la clé
+         * @param id L'identifiant à ranger
+         * @param egal Prédicat indiquant si l'identifiant passé en paramètre a la même clé que id
+         * @return L'identifiant désormais associé à la clé (id, ou celui déjà présent)
+         * 
+         * @b Complexité -temporelle : Θ(1) en moyenne amortie
+         *							 -spatiale : O(1) amortie
+         **/
+        template<class Egal>
+        std::uint32_t inserer(std::uint64_t h, std::uint32_t id, Egal egal);
+
+        /**
+         * @brief Accède aux cases de la table, pour la sérialiser
+         * @return Les cases, dont le nombre est une puissance de 2 (ou nul)
+         * 
+         * @b Complexité Θ(1)
+         **/
+        const Segments<Case> & cases() const;
+
+        /**
+         * @brief Remplace le contenu de la table par des cases sérialisées
+         * @param c Les cases
+         * @param nbCases Le nombre de cases, une puissance de 2 (ou nul)
+         * @param nb Le nombre d'identifiants rangés dans ces cases
+         * @pre Les cases proviennent de cases() d'une table équivalente
+         * 
+         * @b Complexité -temporelle : Θ(nbCases), par simple recopie
+         *							 -spatiale : Θ(nbCases)
+         **/
+        void restaurer(const Case * c, std::size_t nbCases, std::size_t nb);
+
+        /**
+         * @brief Remplace chaque identifiant rangé par son nouveau numéro
+         * @param vers Le nouveau numéro de chaque identifiant rangé
+         * @pre Les clés ne dépendent pas des identifiants : aucune case ne change de place
+         * 
+         * @b Complexité -temporelle : Θ(nombre de cases)
+         *							 -spatiale : O(1)
+         **/
+        void renumeroter(const std::uint32_t * vers);
+
+        /**
+         * @brief Mélange les bits d'un entier (finaliseur de splitmix64)
+         * @param x L'entier à mélanger
+         * @return Un hachage de x dont chaque bit dépend de tous ceux de x
+         * 
+         * @b Complexité Θ(1)
+         **/
+        static std::uint64_t melanger(std::uint64_t x);
+
+        /**
+         * @brief Hache une suite d'octets, indépendamment de la plateforme
+         * @param p Les octets
+         * @param lg Leur nombre
+         * @return Le hachage de la suite
+         * 
+         * @b Complexité Θ(lg)
+         **/
+        static std::uint64_t hacher(const char * p, std::size_t lg);
+
+    private:
+        // Nombre d'octets de contrôle comparés à la fois
+        static const std::size_t GROUPE = 16;
+        static_assert(Segments<std::uint8_t>::TAILLE % GROUPE == 0, "un groupe ne doit pas chevaucher deux segments");
+        // Octet de contrôle d'une case libre ; celui d'une case occupée est sur 7 bits
+        static const std::uint8_t LIBRE = 0x80;
+        // Attributs
+        Segments<Case> tab; // les cases, en nombre puissance de 2
+        Segments<std::uint8_t> controle; // l'octet de contrôle de chaque case
+        std::size_t nb; // le nombre d'identifiants rangés
+        // Méthodes
+
+        /**
+         * @brief Donne l'octet de contrôle d'une empreinte
+         * @param e L'empreinte
+         * @return Ses 7 bits de poids fort, indépendants de la case de départ tant que la table a moins de 2^25 cases
+         * 
+         * @b Complexité Θ(1)
+         **/
+        static std::uint8_t etiquette(std::uint32_t e);
+
+        /**
+         * @brief Compare les octets de contrôle des GROUPE cases d'un groupe
+         * @param i La première case du groupe, multiple de GROUPE
+         * @param t L'octet de contrôle recherché
+         * @param egaux Reçoit un bit par case du groupe dont l'octet vaut t
+         * @param libres Reçoit un bit par case libre du groupe
+         * 
+         * @b Complexité Θ(1)
+         **/
+        void comparer(std::size_t i, std::uint8_t t, std::uint32_t & egaux, std::uint32_t & libres) const;
+
+        /**
+         * @brief Occupe une case libre
+         * @param i La case
+         * @param id L'identifiant à y ranger
+         * @param e L'empreinte de sa clé
+         * 
+         * @b Complexité Θ(1)
+         **/
+        void occuper(std::size_t i, std::uint32_t id, std::uint32_t e);
+
+        /**
+         * @brief Double le nombre de cases et y reclasse les identifiants par leur empreinte
+         * 
+         * @b Complexité -temporelle : Θ(taille())
+         *							 -spatiale : Θ(taille())
+         **/
+        void agrandir();
+};
+
+//--------------------------------------------------------------------
+inline std::uint8_t TableIds::etiquette(std::uint32_t e)
+{
+    return (std::uint8_t)(e >> 25);
+}
+
+//--------------------------------------------------------------------
+inline void TableIds::comparer(std::size_t i, std::uint8_t t, std::uint32_t & egaux, std::uint32_t & libres) const
+{
+#if defined(__SSE2__)
+    __m128i g = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&controle[i]));
+    egaux = (std::uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(g, _mm_set1_epi8((char)t)));
+    libres = (std::uint32_t)_mm_movemask_epi8(g); // seul LIBRE a son bit de poids fort
+#else
+    egaux = libres = 0;
+    for (std::size_t k = 0; k < GROUPE; ++k) {
+        egaux |= (std::uint32_t)(controle[i+k] == t) << k;
+        libres |= (std::uint32_t)(controle[i+k] == LIBRE) << k;
+    }
+#endif
+}
+
+//--------------------------------------------------------------------
+inline void TableIds::occuper(std::size_t i, std::uint32_t id, std::uint32_t e)
+{
+    tab[i] = Case{id, e};
+    controle[i] = etiquette(e);
+}
+
+//--------------------------------------------------------------------
+template<class Egal>
+std::uint32_t TableIds::trouver(std::uint64_t h, Egal egal) const
+{
+    if (tab.empty())
+        return VIDE;
+    std::size_t masque = tab.size()-1;
+    std::uint32_t e = (std::uint32_t)h;
+    std::uint8_t t = etiquette(e);
+    // la case de départ d'abord : la plupart des clés présentes y sont, et une case libre y conclut
+    // sans lire les octets de contrôle, ce qui épargne un défaut de cache
+    std::size_t s = e & masque;
+    __builtin_prefetch(&controle[s]);
+    const Case & depart = tab[s];
+    if (depart.id == VIDE)
+        return VIDE;
+    if (depart.empreinte == e and egal(depart.id))
+        return depart.id;
+    // groupes alignés, le premier privé des cases qui précèdent la case de départ
+    std::size_t i = s & ~(GROUPE-1);
+    for (std::uint32_t retenues = ~0u << (s-i); ; i = (i+GROUPE) & masque, retenues = ~0u)
+    {
+        std::uint32_t egaux, libres;
+        comparer(i, t, egaux, libres);
+        egaux &= retenues;
+        libres &= retenues;
+        // seules comptent les cases qui précèdent la première case libre
+        if (libres != 0)
+            egaux &= (libres & (0u-libres)) - 1;
+        for ( ; egaux != 0; egaux &= egaux-1)
+        {
+            const Case & c = tab[i + (std::size_t)__builtin_ctz(egaux)];
+            if (c.empreinte == e and egal(c.id))
+                return c.id;
+        }
+        if (libres != 0)
+            return VIDE;
+    }
+}
+
+//--------------------------------------------------------------------
+template<class Egal>
+std::uint32_t TableIds::inserer(std::uint64_t h, std::uint32_t id, Egal egal)
+{
+    // taux de remplissage maintenu sous 3/4 : il reste toujours une case libre
+    if ((nb+1)*4 > tab.size()*3)
+        agrandir();
+    std::size_t masque = tab.size()-1;
+    std::uint32_t e = (std::uint32_t)h;
+    std::uint8_t t = etiquette(e);
+    // les cases sont lues sans les dupliquer : seul le segment de la case occupée l'est, s'il est partagé
+    const Segments<Case> & lues = tab;
+    std::size_t s = e & masque, i = s & ~(GROUPE-1);
+    for (std::uint32_t retenues = ~0u << (s-i); ; i = (i+GROUPE) & masque, retenues = ~0u)
+    {
+        std::uint32_t egaux, libres;
+        comparer(i, t, egaux, libres);
+        egaux &= retenues;
+        libres &= retenues;
+        if (libres != 0)
+            egaux &= (libres & (0u-libres)) - 1;
+        for ( ; egaux != 0; egaux &= egaux-1)
+        {
+            const Case & c = lues[i + (std::size_t)__builtin_ctz(egaux)];
+            if (c.empreinte == e and egal(c.id))
+                return c.id;
+        }
+        if (libres != 0)
+        {
+            occuper(i + (std::size_t)__builtin_ctz(libres), id, e);
+            ++nb;
+            return id;
+        }
+    }
+}
+
+#endif // _TABLEIDS_HPP_
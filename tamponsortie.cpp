@@ -0,0 +1,78 @@
+/**
+ * @file tamponsortie.cpp
+ * @date 18/10/2026 Création
+ * @brief Définition des méthodes de la classe TamponSortie
+**/
+
+#include "tamponsortie.hpp" // pour le type TamponSortie
+#include <algorithm> // pour std::max
+
+//--------------------------------------------------------------------
+TamponSortie::TamponSortie(std::ostream & sortie, std::size_t capacite)
+: os(sortie),
+  tampon(std::max<std::size_t>(capacite, 64)), // de quoi mettre en forme un entier ou une date d'un seul tenant
+  occupe(0)
+{}
+
+//--------------------------------------------------------------------
+TamponSortie::~TamponSortie()
+{
+    vider();
+}
+
+//--------------------------------------------------------------------
+void TamponSortie::vider()
+{
+    if (occupe > 0)
+        os.write(tampon.data(), (std::streamsize)occupe);
+    occupe = 0;
+}
+
+//--------------------------------------------------------------------
+void TamponSortie::texte(const char * s, std::size_t lg)
+{
+    if (lg > tampon.size()) {
+        // trop long pour le tampon : écrit directement, après le texte en attente
+        vider();
+        os.write(s, (std::streamsize)lg);
+        return;
+    }
+    reserver(lg);
+    std::memcpy(tampon.data() + occupe, s, lg);
+    occupe += lg;
+}
+
+//--------------------------------------------------------------------
+void TamponSortie::date(std::uint32_t d)
+{
+    std::uint32_t an = d>>9, mois = (d>>5) & 0xF, jour = d & 0x1F;
+    reserver(10);
+    char * p = tampon.data() + occupe;
+    p[0] = (char)('0'+an/1000);
+    p[1] = (char)('0'+an/100%10);
+    p[2] = (char)('0'+an/10%10);
+    p[3] = (char)('0'+an%10);
+    p[4] = '-';
+    p[5] = (char)('0'+mois/10);
+    p[6] = (char)('0'+mois%10);
+    p[7] = '-';
+    p[8] = (char)('0'+jour/10);
+    p[9] = (char)('0'+jour%10);
+    occupe += 10;
+}
+
+//--------------------------------------------------------------------
+void TamponSortie::individu(char sexe, const char * nom, std::size_t lgNom, std::uint32_t d)
+{
+    caractere(sexe);
+    caractere('\t');
+    texte(nom, lgNom);
+    caractere('\t');
+    date(d);
+}
+
+//--------------------------------------------------------------------
+void TamponSortie::individu(const Individu & ind)
+{
+    individu(ind.sexe, ind.nom.data(), ind.nom.size(), ind.date);
+}
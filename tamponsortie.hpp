@@ -0,0 +1,166 @@
+/**
+ * @file tamponsortie.hpp
+ * @date 18/10/2026 Création
+ * @brief Définition de la classe TamponSortie
+**/
+
+#ifndef _TAMPONSORTIE_HPP_
+#define _TAMPONSORTIE_HPP_
+
+#include <ostream> // pour le type std::ostream
+#include <vector> // pour le type std::vector
+#include <cstring> // pour std::memcpy
+#include <cstdint> // pour les types std::uint32_t et std::uint64_t
+#include <cstddef> // pour le type std::size_t
+#include "individu.hpp" // pour le type Individu
+
+/**
+ * @brief La classe TamponSortie accumule un texte dans un grand tampon et l'écrit dans un flux par blocs
+ *
+ * les entiers et les dates sont mis en forme directement dans le tampon, sans passer par les facettes
+ * du flux ni par des chaînes intermédiaires ; le flux ne reçoit que des blocs de la taille du tampon,
+ * jamais de vidage forcé. Le texte restant est écrit par vider ou par le destructeur
+**/
+class TamponSortie
+{
+    public:
+        /**
+         * @brief Constructeur
+         * @param os Le flux de sortie, qui doit survivre au tampon
+         * @param capacite La taille du tampon en octets
+         *
+         * @b Complexité Θ(capacite)
+         **/
+        explicit TamponSortie(std::ostream & os, std::size_t capacite = 1u<<16);
+
+        /// Un tampon n'est pas copiable : son texte serait écrit deux fois
+        TamponSortie(const TamponSortie &) = delete;
+        /// Un tampon n'est pas copiable : son texte serait écrit deux fois
+        TamponSortie & operator=(const TamponSortie &) = delete;
+
+        /**
+         * @brief Destructeur, qui écrit le texte restant
+         *
+         * @b Complexité O(capacite)
+         **/
+        ~TamponSortie();
+
+        /**
+         * @brief Ajoute un caractère
+         * @param c Le caractère
+         *
+         * @b Complexité Θ(1) amortie
+         **/
+        void caractere(char c);
+
+        /**
+         * @brief Ajoute une suite de caractères
+         * @param s Le début de la suite
+         * @param lg Le nombre de caractères
+         *
+         * @b Complexité Θ(lg)
+         **/
+        void texte(const char * s, std::size_t lg);
+
+        /**
+         * @brief Ajoute l'écriture décimale d'un entier
+         * @param n L'entier
+         *
+         * les chiffres sont produits deux par deux à l'aide d'une table
+         *
+         * @b Complexité Θ(nombre de chiffres de n)
+         **/
+        void entier(std::uint64_t n);
+
+        /**
+         * @brief Ajoute une date au format AAAA-MM-JJ
+         * @param d La date codée (voir Individu::coderDate)
+         *
+         * @b Complexité Θ(1)
+         **/
+        void date(std::uint32_t d);
+
+        /**
+         * @brief Ajoute un individu au format "S   NOM   DATE" de Individu::enChaine
+         * @param sexe Son sexe
+         * @param nom Le début de son nom
+         * @param lgNom La longueur de son nom
+         * @param d Sa date de naissance codée
+         *
+         * @b Complexité Θ(lgNom)
+         **/
+        void individu(char sexe, const char * nom, std::size_t lgNom, std::uint32_t d);
+
+        /**
+         * @brief Ajoute un individu au format "S   NOM   DATE" de Individu::enChaine
+         * @param ind L'individu
+         *
+         * @b Complexité Θ(longueur du nom)
+         **/
+        void individu(const Individu & ind);
+
+        /**
+         * @brief Écrit dans le flux le texte accumulé, sans vider le flux lui-même
+         *
+         * @b Complexité O(capacite)
+         **/
+        void vider();
+
+    private:
+        // Attributs
+        std::ostream & os; // le flux de sortie
+        std::vector<char> tampon; // le texte en attente
+        std::size_t occupe; // le nombre de caractères en attente
+        // Méthodes
+
+        /**
+         * @brief Garantit la place pour lg caractères de plus, en écrivant le texte en attente s'il le faut
+         * @param lg Le nombre de caractères à ajouter, au plus la capacité
+         *
+         * @b Complexité O(capacite)
+         **/
+        void reserver(std::size_t lg);
+};
+
+//--------------------------------------------------------------------
+inline void TamponSortie::reserver(std::size_t lg)
+{
+    if (occupe + lg > tampon.size())
+        vider();
+}
+
+//--------------------------------------------------------------------
+inline void TamponSortie::caractere(char c)
+{
+    reserver(1);
+    tampon[occupe++] = c;
+}
+
+//--------------------------------------------------------------------
+inline void TamponSortie::entier(std::uint64_t n)
+{
+    // les chiffres de 00 à 99, deux par deux
+    static const char PAIRES[] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    char chiffres[20]; // 2^64 a 20 chiffres
+    char * p = chiffres + sizeof chiffres;
+    while (n >= 100) {
+        const char * d = PAIRES + 2*(n % 100);
+        n /= 100;
+        *--p = d[1];
+        *--p = d[0];
+    }
+    if (n >= 10) {
+        *--p = PAIRES[2*n+1];
+        *--p = PAIRES[2*n];
+    } else
+        *--p = (char)('0' + n);
+    std::size_t lg = (std::size_t)(chiffres + sizeof chiffres - p);
+    reserver(lg);
+    std::memcpy(tampon.data() + occupe, p, lg);
+    occupe += lg;
+}
+
+#endif // _TAMPONSORTIE_HPP_
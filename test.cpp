@@ -5,9 +5,18 @@
 **/
 
 #include <iostream>
+#include <thread>
+#include <sstream>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <cstdio>
 #include "individu.hpp"
 #include "ancetres.hpp"
 #include "descendants.hpp"
+#include "foretpartagee.hpp"
+#include "ingestion.hpp"
+#include "parente.hpp"
 using namespace std;
 
 /// Programme principal destiné à tester toutes les fonctionnalités des différentes classes implémentées
@@ -74,6 +83,26 @@ int main()
     cout << "b:" << endl << b << endl;
     cout << endl;
     
+    // Tests du refus des dates mal formées, qui donneraient le code d'une autre date : par Individu, au chargement et par estPresent
+    auto refusee = [](const function<void()> & f) {
+    	try { f(); } catch (const invalid_argument &) { return true; }
+    	return false;
+    };
+    for (const char * d : {"2007-01-40", "2007-13-01", "2007-00-15", "19x0-01-01", "2007-1-15"}) {
+    	string date(d);
+    	{ ofstream fic("registre_dates.txt"); fic << "m\tCamille\t" << date << "\n"; }
+    	cout << date << " refusée par Individu " << refusee([&date]() { Individu('m',"Camille",date); })
+    	     << ", au chargement " << refusee([]() { Ancetres("registre_dates.txt"); })
+    	     << ", par estPresent " << refusee([&b,&date]() { b.estPresent('m', "Jean", 4, (date + "    ").data()); }) << endl;
+    }
+    remove("registre_dates.txt");
+    cout << endl;
+
+    // Test de l'export en table
+    cout << "b exporté en CSV :" << endl;
+    b.exporter(cout, ',');
+    cout << endl;
+    
     cout <<endl<< "Press Enter to continue . . ."<<endl<<endl;
     cin.get();
     
@@ -84,6 +113,11 @@ int main()
     	cout << " | " << indRes << " | ";
     cout<<endl<<endl;
     
+    //Test des fonctions idsRacines() et pourChaqueRacine(Visiteur v)
+    size_t nbHommes = 0;
+    b.pourChaqueRacine([&nbHommes](const VueIndividu & v) { if (v.sexe == 'm') ++nbHommes; });
+    cout << b.nbRacines() << " racines, dont " << nbHommes << " hommes" << endl << endl;
+    
     cout <<endl<< "Press Enter to continue . . ."<<endl<<endl;
     cin.get();
     
@@ -92,6 +126,26 @@ int main()
     Ancetres f = b.ancetresCommuns(indTest2,indTest3);
     cout<<f<<endl << endl;
     
+    //Test de la fonction plusProchesAncetresCommuns(Individu ind1, Individu ind2)
+    cout<<"Plus proches ancêtres communs entre Jean et Jacques (distances en générations) : " << endl;
+    for (AncetreCommun ac:b.plusProchesAncetresCommuns(indTest2,indTest3))
+    	cout << b.individu(ac.ancetre) << " : " << ac.d1 << " / " << ac.d2 << endl;
+    cout << endl;
+    
+    //Test des fonctions ancetres(PersonId id, unsigned int maxGen) et afficherSosa(ostream & os, PersonId id, unsigned int maxGen)
+    cout << "Ancêtres de Jean sur 2 générations : " << endl << b.ancetres(indTest2, 2) << endl;
+    cout << "Liste de Sosa de Jean : " << endl;
+    b.afficherSosa(cout, indTest2, 10);
+    cout << endl;
+    
+    //Test de la classe Parente : coefficients de parenté et de consanguinité
+    Parente parente(b);
+    PersonId jean = b.identifiant(indTest2), jacques = b.identifiant(indTest3);
+    cout << "Parenté entre Jean et Jacques : " << parente.parente(jean, jacques)
+         << ", consanguinité de Jean : " << parente.consanguinite(jean) << endl;
+    std::vector<double> mat = parente.matrice({jean, jacques}, 2);
+    cout << "Matrice de parenté de Jean et Jacques : " << mat[0] << " " << mat[1] << " / " << mat[2] << " " << mat[3] << endl << endl;
+    
     cout <<endl<< "Press Enter to continue . . ."<<endl<<endl;
     cin.get();
     
@@ -101,6 +155,70 @@ int main()
     b.fusion(g);
     cout << b << endl << endl;
     
+    //Test de la fonction fusionner(vector<const Ancetres*> forets)
+    Ancetres reunion = Ancetres::fusionner({&g, &b});
+    cout << "Réunion de g et b : " << reunion.taille() << " individus, " << reunion.nbRacines() << " racines" << endl << endl;
+    
+    //Test de la fonction renumeroter() : l'affichage ne change pas
+    ostringstream avant, apres;
+    reunion.afficher(avant);
+    Ancetres renum(reunion);
+    bool sansCycle = renum.renumeroter();
+    renum.afficher(apres);
+    cout << "Renumérotation de la réunion : sans cycle " << sansCycle << ", affichage identique " << (avant.str() == apres.str())
+         << ", Jean passe du numéro " << reunion.identifiant(indTest2) << " au numéro " << renum.identifiant(indTest2) << endl << endl;
+    
+    //Test des deux fusions dans une forêt vide : la réunion renumérotée y garde l'ordre de son fichier
+    Ancetres parCopie, parDeplacement;
+    parCopie.fusion(renum);
+    parDeplacement.fusion(Ancetres(renum));
+    ostringstream copie, deplacement;
+    parCopie.afficher(copie);
+    parDeplacement.afficher(deplacement);
+    cout << "Fusion de la réunion renumérotée dans une forêt vide : même affichage par copie et par déplacement "
+         << (copie.str() == deplacement.str()) << ", identique à la réunion " << (copie.str() == avant.str()) << endl << endl;
+    
+    //Test de la classe ForetPartagee : une version lue n'est pas affectée par les modifications suivantes
+    ForetPartagee partagee(reunion);
+    ForetPartagee::Instantane v1 = partagee.lire();
+    partagee.brouillon().ajouter(Individu('f',"Berthe","1850-06-01"));
+    cout << "Version " << partagee.publier() << " publiée : " << partagee.lire()->taille()
+         << " individus, la version " << v1.version() << " lue avant en a toujours " << v1->taille() << endl << endl;
+    
+    //Test de la classe Ingestion : deux producteurs ajoutent les mêmes individus, les doublons sont reconnus
+    Ingestion ing;
+    thread producteur([&b,&ing]() {
+    	for (PersonId id:b.idsIndividus())
+    		ing.ajouter(b.individu(id));
+    });
+    for (PersonId id:b.idsIndividus())
+    	ing.ajouter(b.individu(id));
+    producteur.join();
+    cout << "Ingestion par deux producteurs de b (" << b.taille() << " individus) : " << ing.terminer().taille() << " individus" << endl << endl;
+    
+    cout <<endl<< "Press Enter to continue . . ."<<endl<<endl;
+    cin.get();
+    
+    //Test de la sauvegarde et du chargement d'un instantané binaire
+    cout<<"________________________________________"<<endl<<"Instantané binaire - h est rechargé depuis la sauvegarde de b : "<<endl;
+    Ancetres h;
+    cout << "sauvegarde : " << b.sauvegarder("registre.bin") << endl;
+    cout << "chargement : " << h.charger("registre.bin") << endl;
+    cout << h << endl << endl;
+    
+    //Test d'un instantané renuméroté : les numéros du registre (rangs d'origine) désignent toujours les mêmes individus
+    Ancetres r(b);
+    r.renumeroter();
+    Ancetres hr;
+    cout << "sauvegarde de b renumérotée : " << r.sauvegarder("registre.bin") << endl;
+    cout << "chargement : " << hr.charger("registre.bin") << endl;
+    PersonId rangJean = b.identifiant(indTest2), rangJacques = b.identifiant(indTest3); // b n'est pas renumérotée
+    cout << "Plus proches ancêtres communs entre Jean (n° " << rangJean+1 << ") et Jacques (n° " << rangJacques+1
+         << ") dans l'instantané renuméroté : " << endl;
+    for (AncetreCommun ac:hr.plusProchesAncetresCommuns(hr.identifiantOrigine(rangJean),hr.identifiantOrigine(rangJacques)))
+    	cout << hr.individu(ac.ancetre) << " : " << ac.d1 << " / " << ac.d2 << endl;
+    cout << endl;
+    
     cout <<endl<< "Press Enter to continue . . ."<<endl<<endl;
     cin.get();
     
@@ -115,7 +233,7 @@ int main()
     	cout << "     hasPere = " << b.hasPere(ind) << endl;
     	if (b.hasPere(ind))
     		cout << "     getPere = " << b.getPere(ind) << endl;
-    		cout << endl;
+    	cout << endl;
     }
     cout << endl;
     
@@ -145,6 +263,15 @@ int main()
     	cout << " | " << indRes << " | ";
     cout<<endl<<endl;
     
+    //Test des fonctions effectifs() et tranche(int kMin, int kMax)
+    cout << "Effectifs par degré :";
+    for (size_t n:c.effectifs())
+    	cout << " " << n;
+    cout << endl << "Degrés 1 à 2 :" << endl;
+    for (const VueIndividu & v:c.tranche(1,2))
+    	cout << " | " << b.individu(v.id) << " | ";
+    cout<<endl<<endl;
+    
     cout <<endl<< "Press Enter to continue . . ."<<endl<<endl;
     cin.get();
     
@@ -155,5 +282,13 @@ int main()
     	cout << " | " << indRes << " | ";
     cout<<endl<<endl;
     
+    //Test de la fonction descendantsCommuns entre deux arbres issus de la même forêt (par leurs identifiants)
+    Descendants e(indTest1,b);
+    res = c.descendantsCommuns(e);
+    cout << c.identifiants().size() << " et " << e.identifiants().size() << " identifiants, " << res.size() << " en commun :" << endl;
+    for (Individu indRes:res)
+    	cout << " | " << indRes << " | ";
+    cout<<endl<<endl;
+    
     return 0;
 }